@@ -3,12 +3,23 @@
  * SPDX-License-Identifier: Apache-2.0 */
 
 #include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#  include <process.h>
+#else
+#  include <csignal>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
 
 #include "device/device.h"
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
+#include "session/merge.h"
 #include "session/session.h"
 
 #include "util/args.h"
@@ -16,12 +27,16 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/string.h"
+#include "util/system.h"
 #ifdef WITH_CYCLES_STANDALONE_GUI
 #  include "util/time.h"
 #  include "util/transform.h"
 #endif
 #include "util/unique_ptr.h"
 #include "util/version.h"
+#ifdef _WIN32
+#  include "util/windows.h"
+#endif
 
 #ifdef WITH_USD
 #  include "hydra/file_reader.h"
@@ -48,6 +63,9 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string profile_json_filepath;
+  int num_processes;
+  int cpu_offset;
 } options;
 
 static void session_print(const string &str)
@@ -139,8 +157,12 @@ static void session_init()
 #endif
 
   if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+    unique_ptr<OIIOOutputDriver> output_driver = make_unique<OIIOOutputDriver>(
+        options.output_filepath, options.output_pass, session_print);
+    if (options.session_params.use_sample_subset) {
+      output_driver->set_num_samples(options.session_params.sample_subset_length);
+    }
+    options.session->set_output_driver(std::move(output_driver));
   }
 
   if (options.session_params.background && !options.quiet) {
@@ -164,9 +186,25 @@ static void session_init()
   options.session->start();
 }
 
+static void session_write_profile_json()
+{
+  RenderStats stats;
+  options.session->collect_statistics(&stats);
+
+  string json = stats.json_report();
+  if (!path_write_text(options.profile_json_filepath, json)) {
+    fprintf(stderr,
+            "Failed to write profiling information to %s\n",
+            options.profile_json_filepath.c_str());
+  }
+}
+
 static void session_exit()
 {
   if (options.session) {
+    if (!options.profile_json_filepath.empty()) {
+      session_write_profile_json();
+    }
     options.session.reset();
   }
 
@@ -361,6 +399,165 @@ static void keyboard(unsigned char key)
 }
 #endif
 
+/* Multi-process rendering.
+ *
+ * The samples are split into contiguous subsets which are rendered by separate processes of
+ * this executable, each of them pinned to its own range of CPU threads. The partial results
+ * are weighted by their number of samples and merged into the final output image. On machines
+ * with many cores and multiple memory nodes this avoids contention of a single process on the
+ * shared scene and kernel state. */
+
+static intptr_t process_spawn(const vector<string> &args)
+{
+  vector<const char *> argv;
+  for (const string &arg : args) {
+    argv.push_back(arg.c_str());
+  }
+  argv.push_back(nullptr);
+
+#ifdef _WIN32
+  /* Arguments are concatenated into a single command line, so quote them. */
+  vector<string> quoted_args;
+  for (const string &arg : args) {
+    quoted_args.push_back("\"" + arg + "\"");
+  }
+  for (size_t i = 0; i < quoted_args.size(); i++) {
+    argv[i] = quoted_args[i].c_str();
+  }
+  return _spawnv(_P_NOWAIT, args[0].c_str(), argv.data());
+#else
+  const pid_t pid = fork();
+  if (pid == 0) {
+    execvp(argv[0], const_cast<char *const *>(argv.data()));
+    _exit(EXIT_FAILURE);
+  }
+  return intptr_t(pid);
+#endif
+}
+
+static bool process_wait(const intptr_t process)
+{
+#ifdef _WIN32
+  int status = 0;
+  if (_cwait(&status, process, 0) == -1) {
+    return false;
+  }
+  return status == 0;
+#else
+  int status = 0;
+  if (waitpid(pid_t(process), &status, 0) == -1) {
+    return false;
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+/* Stop a process and wait for it to exit. */
+static void process_kill(const intptr_t process)
+{
+#ifdef _WIN32
+  TerminateProcess(reinterpret_cast<HANDLE>(process), EXIT_FAILURE);
+#else
+  kill(pid_t(process), SIGTERM);
+#endif
+  process_wait(process);
+}
+
+static bool render_multi_process(const int argc, const char **argv)
+{
+  const int num_processes = options.num_processes;
+  const int num_samples = options.session_params.samples;
+
+  int num_threads = options.session_params.threads;
+  if (num_threads <= 0) {
+    num_threads = max(int(std::thread::hardware_concurrency()), 1);
+  }
+  const int num_threads_per_process = max(num_threads / num_processes, 1);
+
+  vector<string> filepaths;
+  vector<intptr_t> processes;
+
+  for (int i = 0; i < num_processes; i++) {
+    const int sample_offset = int(int64_t(num_samples) * i / num_processes);
+    const int sample_end = int(int64_t(num_samples) * (i + 1) / num_processes);
+    if (sample_end == sample_offset) {
+      continue;
+    }
+
+    const string filepath = string_printf("%s.part%d.exr", options.output_filepath.c_str(), i);
+
+    /* Arguments given later on the command line override earlier ones. */
+    vector<string> args(argv, argv + argc);
+    args.push_back("--background");
+    args.push_back("--quiet");
+    args.push_back("--processes");
+    args.push_back("1");
+    args.push_back("--threads");
+    args.push_back(to_string(num_threads_per_process));
+    args.push_back("--cpu-offset");
+    args.push_back(to_string((i * num_threads_per_process) % num_threads));
+    args.push_back("--sample-subset-offset");
+    args.push_back(to_string(sample_offset));
+    args.push_back("--sample-subset-length");
+    args.push_back(to_string(sample_end - sample_offset));
+    args.push_back("--output");
+    args.push_back(filepath);
+
+    const intptr_t process = process_spawn(args);
+    if (process <= 0) {
+      /* All processes are needed for the full set of samples, stop the ones already started. */
+      fprintf(stderr, "Failed to start render process %d\n", i);
+      for (const intptr_t started_process : processes) {
+        process_kill(started_process);
+      }
+      for (const string &started_filepath : filepaths) {
+        path_remove(started_filepath);
+      }
+      return false;
+    }
+
+    VLOG_INFO << "Started render process " << i << " for samples " << sample_offset << " to "
+              << sample_end << ".";
+
+    filepaths.push_back(filepath);
+    processes.push_back(process);
+  }
+
+  if (!options.quiet) {
+    printf("Rendering with %d processes\n", int(processes.size()));
+  }
+
+  bool success = !processes.empty();
+  for (const intptr_t process : processes) {
+    if (!process_wait(process)) {
+      success = false;
+    }
+  }
+
+  if (success) {
+    ImageMerger merger;
+    merger.input = filepaths;
+    merger.output = options.output_filepath;
+    if (!merger.run()) {
+      fprintf(stderr, "%s\n", merger.error.c_str());
+      success = false;
+    }
+  }
+  else {
+    fprintf(stderr, "Render process failed\n");
+  }
+
+  for (const string &filepath : filepaths) {
+    path_remove(filepath);
+  }
+
+  if (success && !options.quiet) {
+    printf("Written merged result to %s\n", options.output_filepath.c_str());
+  }
+
+  return success;
+}
+
 static void parse_int(OIIO::cspan<const char *> argv, int *i)
 {
   assert(argv.size() == 2);
@@ -382,6 +579,8 @@ static void options_parse(const int argc, const char **argv)
   options.quiet = false;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
+  options.num_processes = 1;
+  options.cpu_offset = -1;
 
   /* device names */
   string device_names;
@@ -407,6 +606,7 @@ static void options_parse(const int argc, const char **argv)
   bool profile = false;
   bool debug = false;
   bool version = false;
+  bool use_numa = false;
   int verbosity = 1;
 
   ap.usage("cycles [options] file.xml");
@@ -437,11 +637,34 @@ static void options_parse(const int argc, const char **argv)
   ap.arg("--height %d:HEIGHT").help("Image height in pixel").action([&](auto argv) {
     parse_int(argv, &options.height);
   });
+  ap.arg("--numa", &use_numa)
+      .help("Bind CPU threads to NUMA nodes and replicate scene data on every node");
   ap.arg("--tile-size %d:TILE_SIZE").help("Tile size in pixels").action([&](auto argv) {
     parse_int(argv, &options.session_params.tile_size);
   });
+  ap.arg("--sample-subset-offset %d:OFFSET")
+      .help("Index of the first sample to render")
+      .action([&](auto argv) {
+        parse_int(argv, &options.session_params.sample_subset_offset);
+        options.session_params.use_sample_subset = true;
+      });
+  ap.arg("--sample-subset-length %d:LENGTH")
+      .help("Number of samples to render, starting from the sample subset offset")
+      .action([&](auto argv) {
+        parse_int(argv, &options.session_params.sample_subset_length);
+        options.session_params.use_sample_subset = true;
+      });
+  ap.arg("--processes %d:PROCESSES")
+      .help("Split samples across this number of render processes and merge their results")
+      .action([&](auto argv) { parse_int(argv, &options.num_processes); });
+  ap.arg("--cpu-offset %d:CPU")
+      .help("Pin the process to CPU threads starting from this index, as many as --threads")
+      .action([&](auto argv) { parse_int(argv, &options.cpu_offset); });
   ap.arg("--list-devices", &list).help("List information about all available devices");
   ap.arg("--profile", &profile).help("Enable profile logging");
+  ap.arg("--profile-json %s:FILE")
+      .help("Write per-kernel, shader, SVM node, bounce and BVH profiling statistics as JSON")
+      .action([&](auto argv) { parse_string(argv, &options.profile_json_filepath); });
 #ifdef WITH_CYCLES_LOGGING
   ap.arg("--debug", &debug).help("Enable debug logging");
   ap.arg("--verbose %d:VERBOSE").help("Set verbosity of the logger").action([&](auto argv) {
@@ -484,7 +707,7 @@ static void options_parse(const int argc, const char **argv)
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.profile_json_filepath.empty();
 
   if (ssname == "osl") {
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -508,6 +731,7 @@ static void options_parse(const int argc, const char **argv)
   bool device_available = false;
   if (!devices.empty()) {
     options.session_params.device = devices.front();
+    options.session_params.device.use_numa = use_numa;
     device_available = true;
   }
 
@@ -536,6 +760,26 @@ static void options_parse(const int argc, const char **argv)
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
   }
+  else if (options.num_processes < 1) {
+    fprintf(stderr, "Invalid number of processes: %d\n", options.num_processes);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.num_processes > 1 && options.output_filepath.empty()) {
+    fprintf(stderr, "Rendering with multiple processes requires an output file path\n");
+    exit(EXIT_FAILURE);
+  }
+  else if (options.num_processes > 1 && !options.profile_json_filepath.empty()) {
+    fprintf(stderr, "Rendering with multiple processes does not support profiling output\n");
+    exit(EXIT_FAILURE);
+  }
+  else if (options.num_processes > 1 && options.session_params.use_sample_subset) {
+    fprintf(stderr, "Rendering with multiple processes does not support sample subsets\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if (options.num_processes > 1) {
+    options.session_params.background = true;
+  }
 }
 
 CCL_NAMESPACE_END
@@ -548,6 +792,19 @@ int main(const int argc, const char **argv)
   path_init();
   options_parse(argc, argv);
 
+  if (options.num_processes > 1) {
+    return render_multi_process(argc, argv) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (options.cpu_offset >= 0) {
+    const int num_cpus = options.session_params.threads > 0 ?
+                             options.session_params.threads :
+                             int(std::thread::hardware_concurrency());
+    if (!system_self_process_set_cpu_affinity(options.cpu_offset, num_cpus)) {
+      fprintf(stderr, "Failed to set CPU affinity, continuing without it\n");
+    }
+  }
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
   if (options.session_params.background) {
 #endif
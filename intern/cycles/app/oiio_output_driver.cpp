@@ -41,7 +41,12 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   const int width = tile.size.x;
   const int height = tile.size.y;
 
-  const ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+  ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+  if (num_samples_ > 0) {
+    const string layer = tile.layer.empty() ? string("RenderLayer") : tile.layer;
+    spec.attribute("cycles." + layer + ".samples", to_string(num_samples_));
+  }
+
   if (!image_output->open(filepath_, spec)) {
     log_("Failed to create image file");
     return;
@@ -19,10 +19,18 @@ class OIIOOutputDriver : public OutputDriver {
 
   void write_render_tile(const Tile &tile) override;
 
+  /* Store the number of rendered samples in the image metadata, using the same convention as
+   * Blender. This allows to merge images rendered with different sample subsets. */
+  void set_num_samples(const int num_samples)
+  {
+    num_samples_ = num_samples;
+  }
+
  protected:
   string filepath_;
   string pass_;
   LogFunction log_;
+  int num_samples_ = 0;
 };
 
 CCL_NAMESPACE_END
@@ -1053,6 +1053,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    texture_memory_budget: IntProperty(
+        name="Texture Memory Budget",
+        description="Maximum memory used by image textures in megabytes, large textures are loaded at a lower "
+        "resolution when they would not fit otherwise (0 for unlimited)",
+        min=0,
+        default=0,
+    )
 
     # Various fine-tuning debug flags
 
@@ -1068,6 +1075,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Trace the paths of a batch of pixels together, executing the same kernel for "
+        "all paths at once for better memory coherence",
+        default=False,
+    )
 
     adaptive_compile_description = "Compile the Cycles GPU kernel with only the feature set required for the current scene"
 
@@ -1570,6 +1583,13 @@ class CyclesPreferences(bpy.types.AddonPreferences):
         default=False,
     )
 
+    use_numa: BoolProperty(
+        name="NUMA-Aware CPU Rendering",
+        description="Bind CPU render threads to the NUMA nodes of the system and replicate scene data on every node, "
+                    "so that threads access local memory. Increases memory usage, useful on multi-socket systems",
+        default=False,
+    )
+
     metalrt: EnumProperty(
         name="MetalRT",
         description="MetalRT for ray tracing uses less memory for scenes which use curves extensively, and can give better "
@@ -1827,6 +1847,10 @@ class CyclesPreferences(bpy.types.AddonPreferences):
         row = layout.row()
         row.prop(self, "compute_device_type", expand=True)
 
+        row = layout.row()
+        row.use_property_split = True
+        row.prop(self, "use_numa")
+
         compute_device_type = self.get_compute_device_type()
         if compute_device_type == 'NONE':
             return
@@ -36,6 +36,8 @@ static void adjust_device_info_from_preferences(DeviceInfo &info, PointerRNA cpr
     info.has_peer_memory = false;
   }
 
+  info.use_numa = get_boolean(cpreferences, "use_numa");
+
   if (info.type == DEVICE_METAL) {
     const MetalRTSetting use_metalrt = (MetalRTSetting)get_enum(
         cpreferences, "metalrt", METALRT_NUM_SETTINGS, METALRT_AUTO);
@@ -33,6 +33,8 @@
 #include "BKE_customdata.hh"
 #include "BKE_mesh.hh"
 
+#include "BLI_task.hh"
+
 CCL_NAMESPACE_BEGIN
 
 /* Tangent Space */
@@ -469,12 +471,15 @@ static void attr_create_uv_map(Scene *scene,
         const blender::VArraySpan b_uv_map = *b_attributes.lookup<blender::float2>(
             uv_name.c_str(), blender::bke::AttrDomain::Corner);
         float2 *fdata = uv_attr->data_float2();
-        for (const int i : corner_tris.index_range()) {
-          const blender::int3 &tri = corner_tris[i];
-          fdata[i * 3 + 0] = make_float2(b_uv_map[tri[0]][0], b_uv_map[tri[0]][1]);
-          fdata[i * 3 + 1] = make_float2(b_uv_map[tri[1]][0], b_uv_map[tri[1]][1]);
-          fdata[i * 3 + 2] = make_float2(b_uv_map[tri[2]][0], b_uv_map[tri[2]][1]);
-        }
+        blender::threading::parallel_for(
+            corner_tris.index_range(), 4096, [&](const blender::IndexRange range) {
+              for (const int i : range) {
+                const blender::int3 &tri = corner_tris[i];
+                fdata[i * 3 + 0] = make_float2(b_uv_map[tri[0]][0], b_uv_map[tri[0]][1]);
+                fdata[i * 3 + 1] = make_float2(b_uv_map[tri[1]][0], b_uv_map[tri[1]][1]);
+                fdata[i * 3 + 2] = make_float2(b_uv_map[tri[2]][0], b_uv_map[tri[2]][1]);
+              }
+            });
       }
 
       /* UV tangent */
@@ -859,10 +864,15 @@ static void create_mesh(Scene *scene,
   }
   mesh->resize_mesh(positions.size(), numtris);
 
+  /* Blender's float3 is not padded like the Cycles one, so positions and normals can not be
+   * shared and are converted in parallel instead. */
   float3 *verts = mesh->get_verts().data();
-  for (const int i : positions.index_range()) {
-    verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
-  }
+  blender::threading::parallel_for(
+      positions.index_range(), 8192, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
+        }
+      });
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
@@ -870,9 +880,12 @@ static void create_mesh(Scene *scene,
 
   if (subdivision || !(use_corner_normals && !corner_normals.is_empty())) {
     const blender::Span<blender::float3> vert_normals = b_mesh.vert_normals();
-    for (const int i : vert_normals.index_range()) {
-      N[i] = make_float3(vert_normals[i][0], vert_normals[i][1], vert_normals[i][2]);
-    }
+    blender::threading::parallel_for(
+        vert_normals.index_range(), 8192, [&](const blender::IndexRange range) {
+          for (const int i : range) {
+            N[i] = make_float3(vert_normals[i][0], vert_normals[i][1], vert_normals[i][2]);
+          }
+        });
   }
 
   const set<ustring> blender_uv_names = get_blender_uv_names(b_mesh);
@@ -898,16 +911,19 @@ static void create_mesh(Scene *scene,
 
     float3 *generated = attr->data_float3();
 
-    for (const int i : positions.index_range()) {
-      blender::float3 value;
-      if (orco) {
-        madd_v3_v3v3v3(value, texspace_location, orco[i], texspace_size);
-      }
-      else {
-        value = positions[i];
-      }
-      generated[i] = make_float3(value[0], value[1], value[2]) * size - loc;
-    }
+    blender::threading::parallel_for(
+        positions.index_range(), 8192, [&](const blender::IndexRange range) {
+          for (const int i : range) {
+            blender::float3 value;
+            if (orco) {
+              madd_v3_v3v3v3(value, texspace_location, orco[i], texspace_size);
+            }
+            else {
+              value = positions[i];
+            }
+            generated[i] = make_float3(value[0], value[1], value[2]) * size - loc;
+          }
+        });
   }
 
   auto clamp_material_index = [&](const int material_index) -> int {
@@ -921,18 +937,24 @@ static void create_mesh(Scene *scene,
     int *shader = mesh->get_shader().data();
 
     const blender::Span<blender::int3> corner_tris = b_mesh.corner_tris();
-    for (const int i : corner_tris.index_range()) {
-      const blender::int3 &tri = corner_tris[i];
-      triangles[i * 3 + 0] = corner_verts[tri[0]];
-      triangles[i * 3 + 1] = corner_verts[tri[1]];
-      triangles[i * 3 + 2] = corner_verts[tri[2]];
-    }
+    blender::threading::parallel_for(
+        corner_tris.index_range(), 8192, [&](const blender::IndexRange range) {
+          for (const int i : range) {
+            const blender::int3 &tri = corner_tris[i];
+            triangles[i * 3 + 0] = corner_verts[tri[0]];
+            triangles[i * 3 + 1] = corner_verts[tri[1]];
+            triangles[i * 3 + 2] = corner_verts[tri[2]];
+          }
+        });
 
     if (!material_indices.is_empty()) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
-      }
+      blender::threading::parallel_for(
+          corner_tris.index_range(), 8192, [&](const blender::IndexRange range) {
+            for (const int i : range) {
+              shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
+            }
+          });
     }
     else {
       std::fill(shader, shader + numtris, 0);
@@ -940,9 +962,12 @@ static void create_mesh(Scene *scene,
 
     if (!sharp_faces.is_empty() && !(use_corner_normals && !corner_normals.is_empty())) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        smooth[i] = !sharp_faces[tri_faces[i]];
-      }
+      blender::threading::parallel_for(
+          corner_tris.index_range(), 8192, [&](const blender::IndexRange range) {
+            for (const int i : range) {
+              smooth[i] = !sharp_faces[tri_faces[i]];
+            }
+          });
     }
     else {
       /* If only face normals are needed, all faces are sharp. */
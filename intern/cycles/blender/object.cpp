@@ -18,10 +18,12 @@
 #include "scene/shader.h"
 #include "scene/shader_graph.h"
 #include "scene/shader_nodes.h"
+#include "scene/stats.h"
 
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/task.h"
+#include "util/time.h"
 
 #include "BKE_duplilist.hh"
 
@@ -623,7 +625,16 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     cancel = progress.get_cancel();
   }
 
-  geom_task_pool.wait_work();
+  {
+    /* Time spent waiting for geometry that is still being synced in parallel. This is part of
+     * the objects and motion sync time, so it must not be counted again in the total. */
+    const scoped_callback_timer timer([this](double time) {
+      if (scene->update_stats) {
+        scene->update_stats->sync.times.add_entry({"geometry (wait)", time, true});
+      }
+    });
+    geom_task_pool.wait_work();
+  }
 
   progress.set_sync_status("");
 
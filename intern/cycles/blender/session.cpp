@@ -391,6 +391,11 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       sync->tag_update();
     }
 
+    /* Enable before sync, so that synchronization times are included in the statistics. */
+    if (!b_engine.is_preview() && background && print_render_stats) {
+      scene->enable_update_stats();
+    }
+
     /* update scene */
     BL::Object b_camera_override(b_engine.camera_override());
     sync->sync_camera(b_render, b_camera_override, width, height, b_rview_name.c_str());
@@ -441,10 +446,6 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     session->reset(effective_session_params, buffer_params);
 
     /* render */
-    if (!b_engine.is_preview() && background && print_render_stats) {
-      scene->enable_update_stats();
-    }
-
     session->start();
     session->wait();
 
@@ -17,6 +17,7 @@
 #include "scene/shader.h"
 #include "scene/shader_graph.h"
 #include "scene/shader_nodes.h"
+#include "scene/stats.h"
 
 #include "device/device.h"
 
@@ -31,6 +32,7 @@
 
 #include "util/hash.h"
 #include "util/log.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -274,26 +276,51 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
 
   const scoped_timer timer;
 
+  SceneUpdateStats *update_stats = scene->update_stats.get();
+  if (update_stats) {
+    update_stats->sync.times.clear();
+  }
+  auto sync_timer = [update_stats](const char *name) {
+    return scoped_callback_timer([update_stats, name](double time) {
+      if (update_stats) {
+        update_stats->sync.times.add_entry({name, time});
+      }
+    });
+  };
+
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
 
   /* TODO(sergey): This feels weak to pass view layer to the integrator, and even weaker to have an
    * implicit check on whether it is a background render or not. What is the nicer thing here? */
   const bool background = !b_v3d;
 
-  sync_view_layer(b_view_layer);
-  sync_integrator(b_view_layer, background, denoise_device_info);
-  sync_film(b_view_layer, b_v3d);
-  sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
-  sync_images();
+  {
+    const scoped_callback_timer settings_timer = sync_timer("settings");
+    sync_view_layer(b_view_layer);
+    sync_integrator(b_view_layer, background, denoise_device_info);
+    sync_film(b_view_layer, b_v3d);
+  }
+  {
+    const scoped_callback_timer shaders_timer = sync_timer("shaders");
+    sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
+  }
+  {
+    const scoped_callback_timer images_timer = sync_timer("images");
+    sync_images();
+  }
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == MOTION_POSITION_CENTER)
   {
+    const scoped_callback_timer objects_timer = sync_timer("objects");
     sync_objects(b_depsgraph, b_v3d);
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  {
+    const scoped_callback_timer motion_timer = sync_timer("motion");
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  }
 
   geometry_synced.clear();
 
@@ -881,6 +908,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   else {
     params.texture_limit = 0;
   }
+  params.texture_memory_budget = get_int(cscene, "texture_memory_budget");
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
@@ -13,7 +13,9 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/tbb.h"
 #include "util/types.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -80,74 +82,35 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   scale = reciprocal(cent_bounds_.size()) * make_float3((float)num_bins);
 
   /* initialize binning counter and bounds */
-  BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
-  int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
+  Bins bins;
+  bins.init(num_bins);
 
-  for (size_t i = 0; i < num_bins; i++) {
-    bin_count[i] = make_int4(0);
-    bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+  /* map geometry to bins */
+  if (size() < PARALLEL_BINNING_SIZE) {
+    bin_primitives(prims, 0, size(), bins);
   }
-
-  /* map geometry to bins, unrolled once */
-  {
-    int64_t i;
-
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
-
-      /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
-
-      const BoundBox bounds0 = get_prim_bounds(prim0);
-      const BoundBox bounds1 = get_prim_bounds(prim1);
-
-      const int4 bin0 = get_bin(bounds0);
-      const int4 bin1 = get_bin(bounds1);
-
-      /* increase bounds for bins for even primitive */
-      const int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      const int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      const int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
-
-      /* increase bounds of bins for odd primitive */
-      const int b10 = (int)extract<0>(bin1);
-      bin_count[b10][0]++;
-      bin_bounds[b10][0].grow(bounds1);
-      const int b11 = (int)extract<1>(bin1);
-      bin_count[b11][1]++;
-      bin_bounds[b11][1].grow(bounds1);
-      const int b12 = (int)extract<2>(bin1);
-      bin_count[b12][2]++;
-      bin_bounds[b12][2].grow(bounds1);
-    }
-
-    /* for uneven number of primitives */
-    if (i < int64_t(size())) {
-      /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
-      const BoundBox bounds0 = get_prim_bounds(prim0);
-      const int4 bin0 = get_bin(bounds0);
-
-      /* increase bounds of bins */
-      const int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      const int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      const int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
+  else {
+    /* Bin chunks in parallel and merge them in order, for a deterministic result. */
+    const size_t chunk_size = PARALLEL_BINNING_SIZE / 4;
+    const size_t num_chunks = divide_up(size(), chunk_size);
+    vector<Bins> chunk_bins(num_chunks);
+
+    parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+      chunk_bins[chunk].init(num_bins);
+      bin_primitives(prims,
+                     chunk * chunk_size,
+                     min((chunk + 1) * chunk_size, size_t(size())),
+                     chunk_bins[chunk]);
+    });
+
+    for (const Bins &chunk : chunk_bins) {
+      bins.merge(chunk, num_bins);
     }
   }
 
+  const int4 *bin_count = bins.count;
+  const auto &bin_bounds = bins.bounds;
+
   /* sweep from right to left and compute parallel prefix of merged bounds */
   float4 r_area[MAX_BINS];  /* area of bounds of primitives on the right */
   float4 r_count[MAX_BINS]; /* number of primitives on the right */
@@ -209,6 +172,88 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   leafSAH = bounds_.half_area() * blocks(size());
 }
 
+void BVHObjectBinning::Bins::init(const size_t num_bins)
+{
+  for (size_t i = 0; i < num_bins; i++) {
+    count[i] = make_int4(0);
+    bounds[i][0] = bounds[i][1] = bounds[i][2] = BoundBox::empty;
+  }
+}
+
+void BVHObjectBinning::Bins::merge(const Bins &other, const size_t num_bins)
+{
+  for (size_t i = 0; i < num_bins; i++) {
+    count[i] = count[i] + other.count[i];
+    for (int dim = 0; dim < 3; dim++) {
+      bounds[i][dim].grow(other.bounds[i][dim]);
+    }
+  }
+}
+
+void BVHObjectBinning::bin_primitives(BVHReference *prims,
+                                      const size_t begin,
+                                      const size_t end,
+                                      Bins &bins) const
+{
+  /* unrolled once */
+  int64_t i;
+
+  for (i = begin; i < int64_t(end) - 1; i += 2) {
+    prefetch_L2(&prims[start() + i + 8]);
+
+    /* map even and odd primitive to bin */
+    const BVHReference &prim0 = prims[start() + i + 0];
+    const BVHReference &prim1 = prims[start() + i + 1];
+
+    const BoundBox bounds0 = get_prim_bounds(prim0);
+    const BoundBox bounds1 = get_prim_bounds(prim1);
+
+    const int4 bin0 = get_bin(bounds0);
+    const int4 bin1 = get_bin(bounds1);
+
+    /* increase bounds for bins for even primitive */
+    const int b00 = (int)extract<0>(bin0);
+    bins.count[b00][0]++;
+    bins.bounds[b00][0].grow(bounds0);
+    const int b01 = (int)extract<1>(bin0);
+    bins.count[b01][1]++;
+    bins.bounds[b01][1].grow(bounds0);
+    const int b02 = (int)extract<2>(bin0);
+    bins.count[b02][2]++;
+    bins.bounds[b02][2].grow(bounds0);
+
+    /* increase bounds of bins for odd primitive */
+    const int b10 = (int)extract<0>(bin1);
+    bins.count[b10][0]++;
+    bins.bounds[b10][0].grow(bounds1);
+    const int b11 = (int)extract<1>(bin1);
+    bins.count[b11][1]++;
+    bins.bounds[b11][1].grow(bounds1);
+    const int b12 = (int)extract<2>(bin1);
+    bins.count[b12][2]++;
+    bins.bounds[b12][2].grow(bounds1);
+  }
+
+  /* for uneven number of primitives */
+  if (i < int64_t(end)) {
+    /* map primitive to bin */
+    const BVHReference &prim0 = prims[start() + i];
+    const BoundBox bounds0 = get_prim_bounds(prim0);
+    const int4 bin0 = get_bin(bounds0);
+
+    /* increase bounds of bins */
+    const int b00 = (int)extract<0>(bin0);
+    bins.count[b00][0]++;
+    bins.bounds[b00][0].grow(bounds0);
+    const int b01 = (int)extract<1>(bin0);
+    bins.count[b01][1]++;
+    bins.bounds[b01][1].grow(bounds0);
+    const int b02 = (int)extract<2>(bin0);
+    bins.count[b02][2]++;
+    bins.bounds[b02][2].grow(bounds0);
+  }
+}
+
 void BVHObjectBinning::split(BVHReference *prims,
                              BVHObjectBinning &left_o,
                              BVHObjectBinning &right_o) const
@@ -58,6 +58,20 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges with at least this many primitives are binned in parallel. */
+  enum { PARALLEL_BINNING_SIZE = 65536 };
+
+  struct Bins {
+    BoundBox bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
+    int4 count[MAX_BINS];         /* number of primitives mapped to bin */
+
+    void init(const size_t num_bins);
+    void merge(const Bins &other, const size_t num_bins);
+  };
+
+  /* map primitives in the given range of the job to bins */
+  void bin_primitives(BVHReference *prims, const size_t begin, const size_t end, Bins &bins) const;
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
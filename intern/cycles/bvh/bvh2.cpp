@@ -18,7 +18,9 @@
 #include "bvh/node.h"
 #include "bvh/unaligned.h"
 
+#include "util/log.h"
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -29,6 +31,13 @@ int BVHStackEntry::encodeIdx() const
   return (node->is_leaf()) ? ~idx : idx;
 }
 
+/* Refit subtrees in parallel up to this depth. */
+static const int REFIT_PARALLEL_DEPTH = 8;
+
+/* Do a full rebuild instead of a refit once the tree is this much worse than when it was built.
+ * Degraded subtrees are not rebuilt individually, the whole BVH is built again. */
+static const float FULL_REBUILD_AREA_RATIO_GROWTH = 2.0f;
+
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
@@ -73,19 +82,35 @@ void BVH2::build(Progress &progress, Stats * /*unused*/)
   /* pack nodes */
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root.get());
+
+  /* Measure the packed tree the same way a refit does, so both ratios can be compared. The build
+   * tree bounds can differ from the primitive bounds, for example with spatial splits. */
+  if (!params.top_level) {
+    build_area_ratio = packed_area_ratio(false);
+  }
 }
 
-void BVH2::refit(Progress &progress)
+bool BVH2::refit(Progress &progress)
 {
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
   if (progress.get_cancel()) {
-    return;
+    return true;
   }
 
   progress.set_substatus("Refitting BVH nodes");
   refit_nodes();
+
+  if (build_area_ratio > 0.0f &&
+      refit_area_ratio > build_area_ratio * FULL_REBUILD_AREA_RATIO_GROWTH)
+  {
+    VLOG_WORK << "Refitted BVH area ratio " << refit_area_ratio << " exceeds build area ratio "
+              << build_area_ratio << ", doing a full rebuild.";
+    return false;
+  }
+
+  return true;
 }
 
 unique_ptr<BVHNode> BVH2::widen_children_nodes(unique_ptr<BVHNode> &&root)
@@ -291,15 +316,30 @@ void BVH2::pack_nodes(const BVHNode *root)
 }
 
 void BVH2::refit_nodes()
+{
+  refit_area_ratio = packed_area_ratio(true);
+}
+
+float BVH2::packed_area_ratio(const bool update_nodes)
 {
   assert(!params.top_level);
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
-  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  float area = 0.0f;
+  refit_node(0, (pack.root_index == -1) ? true : false, update_nodes, bbox, visibility, area, 0);
+
+  const float root_area = bbox.safe_area();
+  return (root_area > 0.0f) ? area / root_area : 0.0f;
 }
 
-void BVH2::refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility)
+void BVH2::refit_node(const int idx,
+                      bool leaf,
+                      const bool update_nodes,
+                      BoundBox &bbox,
+                      uint &visibility,
+                      float &area,
+                      const int depth)
 {
   if (leaf) {
     /* refit leaf node */
@@ -310,6 +350,10 @@ void BVH2::refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility
 
     refit_primitives(c0, c1, bbox, visibility);
 
+    if (!update_nodes) {
+      return;
+    }
+
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     int4 leaf_data[BVH_NODE_LEAF_SIZE];
     leaf_data[0].x = c0;
@@ -330,22 +374,63 @@ void BVH2::refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility
     BoundBox bbox1 = BoundBox::empty;
     uint visibility0 = 0;
     uint visibility1 = 0;
-
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
-
-    if (is_unaligned) {
-      const Transform aligned_space = transform_identity();
-      pack_unaligned_node(
-          idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
+    float area0 = 0.0f;
+    float area1 = 0.0f;
+
+    /* Children write to separate nodes, so subtrees can be refitted in parallel. */
+    if (depth < REFIT_PARALLEL_DEPTH) {
+      parallel_invoke(
+          [&] {
+            refit_node((c0 < 0) ? -c0 - 1 : c0,
+                       (c0 < 0),
+                       update_nodes,
+                       bbox0,
+                       visibility0,
+                       area0,
+                       depth + 1);
+          },
+          [&] {
+            refit_node((c1 < 0) ? -c1 - 1 : c1,
+                       (c1 < 0),
+                       update_nodes,
+                       bbox1,
+                       visibility1,
+                       area1,
+                       depth + 1);
+          });
     }
     else {
-      pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+      refit_node((c0 < 0) ? -c0 - 1 : c0,
+                 (c0 < 0),
+                 update_nodes,
+                 bbox0,
+                 visibility0,
+                 area0,
+                 depth + 1);
+      refit_node((c1 < 0) ? -c1 - 1 : c1,
+                 (c1 < 0),
+                 update_nodes,
+                 bbox1,
+                 visibility1,
+                 area1,
+                 depth + 1);
+    }
+
+    if (update_nodes) {
+      if (is_unaligned) {
+        const Transform aligned_space = transform_identity();
+        pack_unaligned_node(
+            idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
+      }
+      else {
+        pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+      }
     }
 
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    area = bbox.safe_area() + area0 + area1;
   }
 }
 
@@ -42,7 +42,9 @@ class BVH2 : public BVH {
        const vector<Object *> &objects);
 
   void build(Progress &progress, Stats *stats);
-  void refit(Progress &progress);
+  /* Returns false when the refitted tree degraded too much, in which case the caller has to do a
+   * full rebuild of the BVH with #build. */
+  bool refit(Progress &progress);
 
   PackedBVH pack;
 
@@ -82,7 +84,16 @@ class BVH2 : public BVH {
 
   /* refit */
   void refit_nodes();
-  void refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  /* Sum of the inner node areas relative to the root area, with bounds computed from the current
+   * primitives. The packed nodes are only updated to those bounds when requested. */
+  float packed_area_ratio(const bool update_nodes);
+  void refit_node(const int idx,
+                  bool leaf,
+                  const bool update_nodes,
+                  BoundBox &bbox,
+                  uint &visibility,
+                  float &area,
+                  const int depth);
 
   /* Refit range of primitives. */
   void refit_primitives(const int start, const int end, BoundBox &bbox, uint &visibility);
@@ -93,6 +104,11 @@ class BVH2 : public BVH {
 
   /* merge instance BVH's */
   void pack_instances(const size_t nodes_size, const size_t leaf_nodes_size);
+
+  /* Sum of inner node areas relative to the root area, as an estimate of the tree quality.
+   * Refitting grows it when primitives move relative to each other. */
+  float build_area_ratio = 0.0f;
+  float refit_area_ratio = 0.0f;
 };
 
 CCL_NAMESPACE_END
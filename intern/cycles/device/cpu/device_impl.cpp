@@ -40,6 +40,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -59,6 +60,9 @@ CPUDevice::CPUDevice(const DeviceInfo &info_, Stats &stats_, Profiler &profiler_
   embree_device = rtcNewDevice("verbose=0");
 #endif
   need_texture_info = false;
+  need_numa_replicas = false;
+
+  numa_init();
 }
 
 CPUDevice::~CPUDevice()
@@ -68,6 +72,124 @@ CPUDevice::~CPUDevice()
 #endif
 
   texture_info.free();
+  numa_replicas_free();
+}
+
+void CPUDevice::numa_init()
+{
+  if (!info.use_numa) {
+    return;
+  }
+
+  const vector<int> nodes = tbb_numa_nodes();
+  if (nodes.size() < 2) {
+    VLOG_INFO << "NUMA topology is not available or has a single node, not binding threads.";
+    info.use_numa = false;
+    return;
+  }
+
+  /* Distribute threads over the nodes proportionally to the number of threads of the nodes. */
+  vector<int> nodes_concurrency;
+  int64_t total_concurrency = 0;
+  for (const int node : nodes) {
+    nodes_concurrency.push_back(tbb_numa_node_concurrency(node));
+    total_concurrency += nodes_concurrency.back();
+  }
+
+  int64_t accumulated_concurrency = 0;
+  int num_assigned_threads = 0;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    accumulated_concurrency += nodes_concurrency[i];
+    const int threads_end = int(info.cpu_threads * accumulated_concurrency / total_concurrency);
+    const int num_threads = threads_end - num_assigned_threads;
+    if (num_threads > 0) {
+      numa_nodes.push_back({nodes[i], num_threads});
+      num_assigned_threads = threads_end;
+    }
+  }
+
+  if (numa_nodes.size() < 2) {
+    VLOG_INFO << "Not enough threads to use multiple NUMA nodes.";
+    numa_nodes.clear();
+    info.use_numa = false;
+    return;
+  }
+
+  VLOG_INFO << "Binding " << info.cpu_threads << " CPU threads to " << numa_nodes.size()
+            << " NUMA nodes.";
+
+  need_numa_replicas = true;
+}
+
+/* Copy the array to memory which is first written by the threads of the current arena, which
+ * makes the operating system place its pages on their NUMA node. */
+template<typename T>
+static size_t numa_replicate_array(kernel_array<T> &array,
+                                   vector<std::pair<void *, size_t>> &allocations)
+{
+  if (array.data == nullptr || array.width == 0) {
+    return 0;
+  }
+
+  const size_t size = sizeof(T) * array.width;
+  char *data = (char *)util_aligned_malloc(size, MIN_ALIGNMENT_CPU_DATA_TYPES);
+  const char *source = (const char *)array.data;
+
+  parallel_for(blocked_range<size_t>(0, size, 1024 * 1024), [&](const blocked_range<size_t> &r) {
+    memcpy(data + r.begin(), source + r.begin(), r.size());
+  });
+
+  allocations.emplace_back(data, size);
+  array.data = (T *)data;
+
+  return size;
+}
+
+void CPUDevice::numa_replicas_update()
+{
+  if (!need_numa_replicas) {
+    return;
+  }
+
+  numa_replicas_free();
+
+  size_t total_size = 0;
+  for (const CPUNUMANode &node : numa_nodes) {
+    unique_ptr<NUMAReplica> replica = make_unique<NUMAReplica>();
+    replica->kernel_globals = kernel_globals;
+
+    tbb::task_arena arena = tbb_numa_arena_create(node.id, node.num_threads);
+    arena.execute([&]() {
+#define KERNEL_DATA_ARRAY(type, name) \
+  total_size += numa_replicate_array(replica->kernel_globals.name, replica->allocations);
+#include "kernel/data_arrays.h"
+    });
+
+    numa_replicas.push_back(std::move(replica));
+  }
+
+  stats.mem_alloc(total_size);
+
+  VLOG_INFO << "Replicated " << string_human_readable_size(total_size)
+            << " of scene data over " << numa_nodes.size() << " NUMA nodes.";
+
+  need_numa_replicas = false;
+}
+
+void CPUDevice::numa_replicas_free()
+{
+  for (const unique_ptr<NUMAReplica> &replica : numa_replicas) {
+    for (const std::pair<void *, size_t> &allocation : replica->allocations) {
+      util_aligned_free(allocation.first, allocation.second);
+      stats.mem_free(allocation.second);
+    }
+  }
+  numa_replicas.clear();
+}
+
+vector<CPUNUMANode> CPUDevice::get_cpu_numa_nodes() const
+{
+  return numa_nodes;
 }
 
 BVHLayoutMask CPUDevice::get_bvh_layout_mask(uint /*kernel_features*/) const
@@ -206,6 +328,7 @@ void CPUDevice::global_alloc(device_memory &mem)
             << string_human_readable_size(mem.memory_size()) << ")";
 
   kernel_global_memory_copy(&kernel_globals, mem.name, mem.host_pointer, mem.data_size);
+  need_numa_replicas = !numa_nodes.empty();
 
   mem.device_pointer = (device_ptr)mem.host_pointer;
   mem.device_size = mem.memory_size();
@@ -215,6 +338,11 @@ void CPUDevice::global_alloc(device_memory &mem)
 void CPUDevice::global_free(device_memory &mem)
 {
   if (mem.device_pointer) {
+    /* Unset the freed array, so that the NUMA replicas drop their copy of it when they are
+     * updated, instead of reading freed memory. */
+    kernel_global_memory_copy(&kernel_globals, mem.name, nullptr, 0);
+    need_numa_replicas = !numa_nodes.empty();
+
     mem.device_pointer = 0;
     stats.mem_free(mem.device_size);
     mem.device_size = 0;
@@ -305,8 +433,26 @@ void CPUDevice::get_cpu_kernel_thread_globals(
 
   kernel_thread_globals.clear();
   OSLGlobals *osl_globals = get_cpu_osl_memory();
-  for (int i = 0; i < info.cpu_threads; i++) {
-    kernel_thread_globals.emplace_back(kernel_globals, osl_globals, profiler, i);
+
+  if (numa_nodes.empty()) {
+    for (int i = 0; i < info.cpu_threads; i++) {
+      kernel_thread_globals.emplace_back(kernel_globals, osl_globals, profiler, i);
+    }
+    return;
+  }
+
+  /* Threads of every node use the scene data replicated on that node. */
+  numa_replicas_update();
+
+  int thread_index = 0;
+  for (size_t i = 0; i < numa_nodes.size(); i++) {
+    KernelGlobalsCPU &replica_kernel_globals = numa_replicas[i]->kernel_globals;
+    replica_kernel_globals.data = kernel_globals.data;
+
+    for (int j = 0; j < numa_nodes[i].num_threads; j++) {
+      kernel_thread_globals.emplace_back(
+          replica_kernel_globals, osl_globals, profiler, thread_index++);
+    }
   }
 }
 
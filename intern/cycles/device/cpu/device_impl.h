@@ -44,6 +44,18 @@ class CPUDevice : public Device {
   device_vector<TextureInfo> texture_info;
   bool need_texture_info;
 
+  /* NUMA nodes the kernel threads are bound to, empty when NUMA is not used. */
+  vector<CPUNUMANode> numa_nodes;
+
+  /* Copy of the global memory arrays placed on a NUMA node, so that threads bound to the node
+   * read scene data from local memory. Textures are not replicated. */
+  struct NUMAReplica {
+    KernelGlobalsCPU kernel_globals;
+    vector<std::pair<void *, size_t>> allocations;
+  };
+  vector<unique_ptr<NUMAReplica>> numa_replicas;
+  bool need_numa_replicas;
+
 #ifdef WITH_OSL
   OSLGlobals osl_globals;
 #endif
@@ -88,9 +100,14 @@ class CPUDevice : public Device {
   void get_cpu_kernel_thread_globals(
       vector<ThreadKernelGlobalsCPU> &kernel_thread_globals) override;
   OSLGlobals *get_cpu_osl_memory() override;
+  vector<CPUNUMANode> get_cpu_numa_nodes() const override;
 
  protected:
   bool load_kernels(uint /*kernel_features*/) override;
+
+  void numa_init();
+  void numa_replicas_update();
+  void numa_replicas_free();
 };
 
 CCL_NAMESPACE_END
@@ -31,6 +31,8 @@ class CPUKernels {
   IntegratorInitFunction integrator_init_from_camera;
   IntegratorInitFunction integrator_init_from_bake;
   IntegratorShadeFunction integrator_megakernel;
+  /* Execute a single kernel of the path, for the wavefront mode of the CPU path tracer. */
+  IntegratorShadeFunction integrator_megakernel_step;
 
   /* Shader evaluation. */
 
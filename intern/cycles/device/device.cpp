@@ -54,12 +54,11 @@ void Device::build_bvh(BVH *bvh, Progress &progress, bool refit)
   assert(bvh->params.bvh_layout == BVH_LAYOUT_BVH2);
 
   BVH2 *const bvh2 = static_cast<BVH2 *>(bvh);
-  if (refit) {
-    bvh2->refit(progress);
-  }
-  else {
-    bvh2->build(progress, &stats);
+  if (refit && bvh2->refit(progress)) {
+    return;
   }
+  /* Full rebuild, also when the refit degraded the tree too much. */
+  bvh2->build(progress, &stats);
 }
 
 unique_ptr<Device> Device::create(const DeviceInfo &info,
@@ -496,6 +495,11 @@ OSLGlobals *Device::get_cpu_osl_memory()
   return nullptr;
 }
 
+vector<CPUNUMANode> Device::get_cpu_numa_nodes() const
+{
+  return {};
+}
+
 void *Device::host_alloc(const MemoryType /*type*/, const size_t size)
 {
   return util_aligned_malloc(size, MIN_ALIGNMENT_CPU_DATA_TYPES);
@@ -96,6 +96,7 @@ class DeviceInfo {
                                                       * kernels (Metal only). */
   DenoiserTypeMask denoisers;                        /* Supported denoiser types. */
   int cpu_threads;
+  bool use_numa; /* Bind CPU threads to NUMA nodes and replicate scene data on every node. */
   vector<DeviceInfo> multi_devices;
   string error_msg;
 
@@ -105,6 +106,7 @@ class DeviceInfo {
     id = "CPU";
     num = 0;
     cpu_threads = 0;
+    use_numa = false;
     display_device = false;
     has_nanovdb = false;
     has_mnee = true;
@@ -134,6 +136,14 @@ class DeviceInfo {
   bool contains_device_type(const DeviceType type) const;
 };
 
+/* Group of CPU kernel threads bound to a NUMA node. */
+struct CPUNUMANode {
+  /* Identifier of the NUMA node. */
+  int id;
+  /* Number of kernel threads running on this node. */
+  int num_threads;
+};
+
 /* Device */
 
 class Device {
@@ -223,6 +233,10 @@ class Device {
       vector<ThreadKernelGlobalsCPU> & /*kernel_thread_globals*/);
   /* Get OpenShadingLanguage memory buffer. */
   virtual OSLGlobals *get_cpu_osl_memory();
+  /* Get NUMA nodes the CPU kernel threads are distributed over. Kernel thread globals are ordered
+   * by node, so the globals of the first node come first. Empty when threads are not bound to
+   * NUMA nodes. */
+  virtual vector<CPUNUMANode> get_cpu_numa_nodes() const;
 
   /* Acceleration structure building. */
   virtual void build_bvh(BVH *bvh, Progress &progress, bool refit);
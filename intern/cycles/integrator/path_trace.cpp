@@ -1004,52 +1004,61 @@ bool PathTrace::copy_render_tile_from_device()
   return success;
 }
 
-static string get_layer_view_name(const RenderBuffers &buffers)
+static string get_layer_view_name(const BufferParams &params)
 {
   string result;
 
-  if (!buffers.params.layer.empty()) {
-    result += string(buffers.params.layer);
+  if (!params.layer.empty()) {
+    result += string(params.layer);
   }
 
-  if (!buffers.params.view.empty()) {
+  if (!params.view.empty()) {
     if (!result.empty()) {
       result += ", ";
     }
-    result += string(buffers.params.view);
+    result += string(params.view);
   }
 
   return result;
 }
 
+/* Number of rows above and below of a band of the full frame buffer which are passed to the
+ * denoiser, so that the denoised bands join without visible seams. */
+static constexpr int FULL_BUFFER_DENOISE_OVERLAP = 64;
+
 void PathTrace::process_full_buffer_from_disk(string_view filename)
 {
   VLOG_WORK << "Processing full frame buffer file " << filename;
 
   progress_set_status("Reading full buffer from disk");
 
-  RenderBuffers full_frame_buffers(cpu_device_.get());
-
+  BufferParams full_frame_params;
   DenoiseParams denoise_params;
-  if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
-    }
+  if (!tile_manager_.read_full_buffer_params_from_disk(
+          filename, &full_frame_params, &denoise_params))
+  {
+    full_buffer_read_error();
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  /* Process the full frame in bands of rows, so that memory usage is bounded by the size of the
+   * band rather than by the frame resolution. The band covers roughly as many pixels as a render
+   * tile does, and every band is read, denoised and written before the next one is read. */
+  const int2 tile_size = tile_manager_.get_tile_size();
+  const size_t band_num_pixels = (tile_size.x && tile_size.y) ?
+                                     size_t(tile_size.x) * tile_size.y :
+                                     size_t(full_frame_params.width) * full_frame_params.height;
+  const int band_height = max(int(align_up(divide_up(band_num_pixels,
+                                                     max(full_frame_params.width, 1)),
+                                           TileManager::IMAGE_TILE_SIZE)),
+                              TileManager::IMAGE_TILE_SIZE);
 
-  render_state_.has_denoised_result = false;
+  const bool use_denoise = denoise_params.use && denoiser_;
+  const int band_overlap = use_denoise ? FULL_BUFFER_DENOISE_OVERLAP : 0;
 
-  if (denoise_params.use && denoiser_ && !progress_->get_cancel()) {
-    progress_set_status(layer_view_name, "Denoising");
+  const string layer_view_name = get_layer_view_name(full_frame_params);
 
+  if (use_denoise) {
     /* If GPU should be used is not based on file metadata. */
     denoise_params.use_gpu = render_scheduler_.is_denoiser_gpu_used();
 
@@ -1060,22 +1069,62 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
      *  - The next rendering will go via Session's `run_update_for_next_iteration` which will
      *    ensure proper denoiser is used. */
     set_denoiser_params(denoise_params);
+  }
 
-    /* Number of samples doesn't matter too much, since the samples count pass will be used. */
-    denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
+  const int window_y_end = full_frame_params.window_y + full_frame_params.window_height;
 
-    render_state_.has_denoised_result = true;
-  }
+  VLOG_WORK << "Processing full frame buffer in bands of " << band_height << " rows.";
+
+  for (int band_y = full_frame_params.window_y; band_y < window_y_end; band_y += band_height) {
+    if (progress_ && progress_->get_cancel()) {
+      return;
+    }
 
-  full_frame_state_.render_buffers = &full_frame_buffers;
+    const int band_window_height = min(band_height, window_y_end - band_y);
+
+    RenderBuffers band_buffers(cpu_device_.get());
+    if (!tile_manager_.read_full_buffer_rows_from_disk(
+            filename, band_y, band_window_height, band_overlap, &band_buffers))
+    {
+      full_buffer_read_error();
+      return;
+    }
 
-  progress_set_status(layer_view_name, "Finishing");
+    render_state_.has_denoised_result = false;
 
-  /* Write the full result pretending that there is a single tile.
-   * Requires some state change, but allows to use same communication API with the software. */
-  tile_buffer_write();
+    if (use_denoise && !progress_->get_cancel()) {
+      progress_set_status(layer_view_name, "Denoising");
 
-  full_frame_state_.render_buffers = nullptr;
+      /* Number of samples doesn't matter too much, since the samples count pass will be used. */
+      denoiser_->denoise_buffer(band_buffers.params, &band_buffers, 0, false);
+
+      render_state_.has_denoised_result = true;
+    }
+
+    full_frame_state_.render_buffers = &band_buffers;
+    full_frame_state_.offset = make_int2(0, band_y - full_frame_params.window_y);
+
+    progress_set_status(layer_view_name, "Finishing");
+
+    /* Write the band result pretending that it is a regular tile.
+     * Requires some state change, but allows to use same communication API with the software. */
+    tile_buffer_write();
+
+    full_frame_state_.render_buffers = nullptr;
+    full_frame_state_.offset = make_int2(0, 0);
+  }
+}
+
+void PathTrace::full_buffer_read_error()
+{
+  const string error_message = "Error reading tiles from file";
+  if (progress_) {
+    progress_->set_error(error_message);
+    progress_->set_cancel(error_message);
+  }
+  else {
+    LOG(ERROR) << error_message;
+  }
 }
 
 int PathTrace::get_num_render_tile_samples() const
@@ -1148,7 +1197,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
@@ -1237,6 +1286,10 @@ static string full_device_info_description(const DeviceInfo &device_info)
 
   if (device_info.type == DEVICE_CPU) {
     full_description += " (" + to_string(device_info.cpu_threads) + " threads)";
+
+    if (device_info.use_numa) {
+      full_description += " (NUMA)";
+    }
   }
 
   full_description += " [" + device_info.id + "]";
@@ -137,7 +137,8 @@ class PathTrace {
   bool copy_render_tile_from_device();
 
   /* Read given full-frame file from disk, perform needed processing and write it to the software
-   * via the write callback. */
+   * via the write callback.
+   * The file is processed in bands of rows, each of them is written as a separate tile. */
   void process_full_buffer_from_disk(string_view filename);
 
   /* Get number of samples in the current big tile render buffers. */
@@ -246,6 +247,9 @@ class PathTrace {
 
   void progress_set_status(const string &status, const string &substatus = "");
 
+  /* Report failure of reading the full frame buffer file from disk. */
+  void full_buffer_read_error();
+
   /* Destroy GPU resources (such as graphics interop) used by work. */
   void destroy_gpu_resources();
 
@@ -355,6 +359,8 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+    /* Offset of the window of the render buffers within the full frame. */
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
@@ -4,6 +4,8 @@
 
 #include "integrator/path_trace_work_cpu.h"
 
+#include <atomic>
+
 #include "device/cpu/kernel.h"
 #include "device/device.h"
 
@@ -19,6 +21,9 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/algorithm.h"
+#include "util/debug.h"
+#include "util/log.h"
 #include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
@@ -32,6 +37,10 @@ static inline tbb::task_arena local_tbb_arena_create(const Device *device)
   return tbb::task_arena(device->info.cpu_threads);
 }
 
+/* Number of pixels whose paths are traced together in the wavefront mode. Large enough to group
+ * many paths executing the same kernel, small enough for the path states to stay in cache. */
+static constexpr int WAVEFRONT_BATCH_SIZE = 64;
+
 /* Get ThreadKernelGlobalsCPU for the current thread. */
 static inline ThreadKernelGlobalsCPU *kernel_thread_globals_get(
     vector<ThreadKernelGlobalsCPU> &kernel_thread_globals)
@@ -43,6 +52,67 @@ static inline ThreadKernelGlobalsCPU *kernel_thread_globals_get(
   return &kernel_thread_globals[thread_index];
 }
 
+/* Run `func(work_index, kernel_globals)` for all work indices in [0, work_size) on the threads of
+ * the device.
+ *
+ * When the device binds its threads to NUMA nodes, every node gets its own arena whose threads
+ * use the kernel globals with the scene data replicated on that node. The work is pulled by the
+ * nodes in chunks, to balance the load between nodes. */
+template<typename Func>
+static void parallel_for_kernel_threads(const Device *device,
+                                        vector<ThreadKernelGlobalsCPU> &kernel_thread_globals,
+                                        const int64_t work_size,
+                                        const Func &func)
+{
+  const vector<CPUNUMANode> numa_nodes = device->get_cpu_numa_nodes();
+
+  if (numa_nodes.empty()) {
+    tbb::task_arena local_arena = local_tbb_arena_create(device);
+    local_arena.execute([&]() {
+      parallel_for(int64_t(0), work_size, [&](int64_t work_index) {
+        func(work_index, kernel_thread_globals_get(kernel_thread_globals));
+      });
+    });
+    return;
+  }
+
+  const int num_nodes = numa_nodes.size();
+  const int64_t chunk_size = std::max<int64_t>(divide_up(work_size, int64_t(num_nodes) * 16), 1);
+  const int64_t num_chunks = divide_up(work_size, chunk_size);
+  std::atomic<int64_t> next_chunk = 0;
+
+  vector<unique_ptr<tbb::task_arena>> arenas;
+  vector<unique_ptr<tbb::task_group>> task_groups;
+
+  int thread_offset = 0;
+  for (const CPUNUMANode &node : numa_nodes) {
+    arenas.push_back(
+        make_unique<tbb::task_arena>(tbb_numa_arena_create(node.id, node.num_threads)));
+    task_groups.push_back(make_unique<tbb::task_group>());
+
+    tbb::task_group &task_group = *task_groups.back();
+    arenas.back()->execute([&, thread_offset]() {
+      task_group.run([&, thread_offset]() {
+        for (int64_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+          const int64_t chunk_begin = chunk * chunk_size;
+          const int64_t chunk_end = std::min<int64_t>(chunk_begin + chunk_size, work_size);
+          parallel_for(chunk_begin, chunk_end, [&](int64_t work_index) {
+            const int thread_index = thread_offset +
+                                     tbb::this_task_arena::current_thread_index();
+            func(work_index, &kernel_thread_globals[thread_index]);
+          });
+        }
+      });
+    });
+
+    thread_offset += node.num_threads;
+  }
+
+  for (int i = 0; i < num_nodes; i++) {
+    arenas[i]->execute([&]() { task_groups[i]->wait(); });
+  }
+}
+
 PathTraceWorkCPU::PathTraceWorkCPU(Device *device,
                                    Film *film,
                                    DeviceScene *device_scene,
@@ -57,6 +127,8 @@ void PathTraceWorkCPU::init_execution()
 {
   /* Cache per-thread kernel globals. */
   device_->get_cpu_kernel_thread_globals(kernel_thread_globals_);
+  wavefront_thread_states_.clear();
+  wavefront_thread_states_.resize(kernel_thread_globals_.size());
 }
 
 void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
@@ -74,32 +146,66 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
-  tbb::task_arena local_arena = local_tbb_arena_create(device_);
-  local_arena.execute([&]() {
-    parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
-      if (is_cancel_requested()) {
-        return;
-      }
-
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
-
-      KernelWorkTile work_tile;
-      work_tile.x = effective_buffer_params_.full_x + x;
-      work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
-      work_tile.h = 1;
-      work_tile.start_sample = start_sample;
-      work_tile.sample_offset = sample_offset;
-      work_tile.num_samples = 1;
-      work_tile.offset = effective_buffer_params_.offset;
-      work_tile.stride = effective_buffer_params_.stride;
-
-      ThreadKernelGlobalsCPU *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+  /* The wavefront mode keeps multiple paths in flight per thread, which is not supported by the
+   * per-thread path guiding storage. */
+  bool use_wavefront = DebugFlags().cpu.wavefront;
+#ifdef WITH_PATH_GUIDING
+  if (device_scene_->data.integrator.use_guiding || device_scene_->data.integrator.train_guiding) {
+    use_wavefront = false;
+  }
+#endif
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
-    });
-  });
+  if (use_wavefront) {
+    VLOG_INFO << "Rendering " << samples_num << " samples with CPU wavefront path tracing.";
+    const int64_t batches_num = divide_up(total_pixels_num, WAVEFRONT_BATCH_SIZE);
+    parallel_for_kernel_threads(
+        device_,
+        kernel_thread_globals_,
+        batches_num,
+        [&](int64_t batch_index, ThreadKernelGlobalsCPU *kernel_globals) {
+          if (is_cancel_requested()) {
+            return;
+          }
+
+          const int64_t work_index_start = batch_index * WAVEFRONT_BATCH_SIZE;
+          const int work_size = std::min<int64_t>(WAVEFRONT_BATCH_SIZE,
+                                                  total_pixels_num - work_index_start);
+
+          render_samples_wavefront(kernel_globals,
+                                   work_index_start,
+                                   work_size,
+                                   start_sample,
+                                   samples_num,
+                                   sample_offset);
+        });
+  }
+  else {
+    parallel_for_kernel_threads(
+        device_,
+        kernel_thread_globals_,
+        total_pixels_num,
+        [&](int64_t work_index, ThreadKernelGlobalsCPU *kernel_globals) {
+          if (is_cancel_requested()) {
+            return;
+          }
+
+          const int y = work_index / image_width;
+          const int x = work_index - y * image_width;
+
+          KernelWorkTile work_tile;
+          work_tile.x = effective_buffer_params_.full_x + x;
+          work_tile.y = effective_buffer_params_.full_y + y;
+          work_tile.w = 1;
+          work_tile.h = 1;
+          work_tile.start_sample = start_sample;
+          work_tile.sample_offset = sample_offset;
+          work_tile.num_samples = 1;
+          work_tile.offset = effective_buffer_params_.offset;
+          work_tile.stride = effective_buffer_params_.stride;
+
+          render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+        });
+  }
   if (device_->profiler.active()) {
     for (ThreadKernelGlobalsCPU &kernel_globals : kernel_thread_globals_) {
       kernel_globals.stop_profiling();
@@ -165,6 +271,152 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                                                const int64_t work_index_start,
+                                                const int work_size,
+                                                const int start_sample,
+                                                const int samples_num,
+                                                const int sample_offset)
+{
+  const bool has_bake = device_scene_->data.bake.use;
+  const bool has_shadow_catcher = device_scene_->data.integrator.has_shadow_catcher;
+  const int64_t image_width = effective_buffer_params_.width;
+
+  /* Path states are reused across batches, they are too big to allocate for every batch. */
+  vector<IntegratorStateCPU> &thread_states =
+      wavefront_thread_states_[kernel_globals - kernel_thread_globals_.data()];
+  if (thread_states.empty()) {
+    thread_states.resize(WAVEFRONT_BATCH_SIZE * 2);
+  }
+
+  /* The kernel splits shadow catcher paths into the state following the main path state, see
+   * #integrator_state_shadow_catcher_split. Interleave the states of the pixels accordingly, in
+   * the same way as the two states of the megakernel. */
+  const int states_stride = has_shadow_catcher ? 2 : 1;
+  IntegratorStateCPU *states = thread_states.data();
+  for (int i = 0; i < work_size * states_stride; i++) {
+    path_state_init_queues(&states[i]);
+  }
+
+  vector<KernelWorkTile> work_tiles(work_size);
+  for (int i = 0; i < work_size; i++) {
+    const int64_t work_index = work_index_start + i;
+    const int y = work_index / image_width;
+    const int x = work_index - y * image_width;
+
+    KernelWorkTile &work_tile = work_tiles[i];
+    work_tile.x = effective_buffer_params_.full_x + x;
+    work_tile.y = effective_buffer_params_.full_y + y;
+    work_tile.w = 1;
+    work_tile.h = 1;
+    work_tile.start_sample = start_sample;
+    work_tile.sample_offset = sample_offset;
+    work_tile.num_samples = 1;
+    work_tile.offset = effective_buffer_params_.offset;
+    work_tile.stride = effective_buffer_params_.stride;
+  }
+
+  /* Pixels for which no more samples are needed, as decided by adaptive sampling. */
+  vector<bool> pixel_done(work_size, false);
+  float *render_buffer = buffers_->buffer.data();
+
+  for (int sample = 0; sample < samples_num; ++sample) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    for (int i = 0; i < work_size; i++) {
+      if (pixel_done[i]) {
+        continue;
+      }
+      IntegratorStateCPU *state = &states[i * states_stride];
+      const bool initialized = has_bake ?
+                                   kernels_.integrator_init_from_bake(
+                                       kernel_globals, state, &work_tiles[i], render_buffer) :
+                                   kernels_.integrator_init_from_camera(
+                                       kernel_globals, state, &work_tiles[i], render_buffer);
+      if (!initialized) {
+        pixel_done[i] = true;
+      }
+      ++work_tiles[i].start_sample;
+    }
+
+    render_paths_wavefront(kernel_globals, states, work_size, states_stride, render_buffer);
+
+    /* Shadow catcher paths write to the same pixels as the main paths, trace them afterwards to
+     * accumulate in the same order as the megakernel. */
+    if (has_shadow_catcher) {
+      render_paths_wavefront(kernel_globals, states + 1, work_size, states_stride, render_buffer);
+    }
+  }
+}
+
+/* Kernel which is executed next for the path state, matching the order of the megakernel. */
+static DeviceKernel integrator_state_next_kernel(const IntegratorStateCPU &state)
+{
+  if (state.shadow.shadow_path.queued_kernel) {
+    return DeviceKernel(state.shadow.shadow_path.queued_kernel);
+  }
+  if (state.ao.shadow_path.queued_kernel) {
+    return DeviceKernel(state.ao.shadow_path.queued_kernel);
+  }
+  return DeviceKernel(state.path.queued_kernel);
+}
+
+void PathTraceWorkCPU::render_paths_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                                              IntegratorStateCPU *states,
+                                              const int states_num,
+                                              const int states_stride,
+                                              float *render_buffer)
+{
+  /* Indices of the states, sorted by the kernel they execute next. */
+  vector<int> kernel_states(states_num);
+  vector<uint16_t> state_kernels(states_num);
+
+  while (true) {
+    int kernel_offsets[DEVICE_KERNEL_INTEGRATOR_NUM + 1] = {0};
+    int active_states_num = 0;
+    for (int i = 0; i < states_num; i++) {
+      const DeviceKernel kernel = integrator_state_next_kernel(states[i * states_stride]);
+      state_kernels[i] = kernel;
+      if (kernel != 0) {
+        kernel_offsets[kernel + 1]++;
+        active_states_num++;
+      }
+    }
+    if (active_states_num == 0) {
+      break;
+    }
+
+    /* Counting sort, keeping states in pixel order within a kernel. */
+    for (int kernel = 0; kernel < DEVICE_KERNEL_INTEGRATOR_NUM; kernel++) {
+      kernel_offsets[kernel + 1] += kernel_offsets[kernel];
+    }
+    for (int i = 0; i < states_num; i++) {
+      if (state_kernels[i] != 0) {
+        kernel_states[kernel_offsets[state_kernels[i]]++] = i;
+      }
+    }
+
+    /* Sort surface shading by object, so that the same shaders and textures tend to be evaluated
+     * one after the other. The kernel offsets now point to the end of each kernel's range. */
+    const int surface_end = kernel_offsets[DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE];
+    const int surface_start = kernel_offsets[DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE - 1];
+    std::stable_sort(kernel_states.begin() + surface_start,
+                     kernel_states.begin() + surface_end,
+                     [&](const int a, const int b) {
+                       return states[a * states_stride].isect.object <
+                              states[b * states_stride].isect.object;
+                     });
+
+    /* Advance every active path by one kernel. */
+    for (int i = 0; i < active_states_num; i++) {
+      kernels_.integrator_megakernel_step(
+          kernel_globals, &states[kernel_states[i] * states_stride], render_buffer);
+    }
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        const int num_samples)
@@ -74,6 +74,24 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Wavefront variant of the path tracing routine: renders samples of a batch of pixels, advancing
+   * all their paths together one kernel at a time. */
+  void render_samples_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                                const int64_t work_index_start,
+                                const int work_size,
+                                const int start_sample,
+                                const int samples_num,
+                                const int sample_offset);
+
+  /* Execute kernels for the given path states until all paths are finished. States which execute
+   * the same kernel next are grouped together. The states are `states_stride` apart, so that the
+   * main and shadow catcher states of pixels can be interleaved. */
+  void render_paths_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                              IntegratorStateCPU *states,
+                              const int states_num,
+                              const int states_stride,
+                              float *render_buffer);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +101,9 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<ThreadKernelGlobalsCPU> kernel_thread_globals_;
+
+  /* Path states of every thread for the wavefront mode, allocated on first use. */
+  vector<vector<IntegratorStateCPU>> wavefront_thread_states_;
 };
 
 CCL_NAMESPACE_END
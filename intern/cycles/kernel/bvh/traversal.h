@@ -40,6 +40,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(KernelGlobals kg,
   /* traversal variables in registers */
   int stack_ptr = 0;
   int node_addr = kernel_data.bvh.root;
+  PROFILING_BVH_TRAVERSAL_INIT();
 
   /* ray parameters in registers */
   float3 P = ray->P;
@@ -62,6 +63,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(KernelGlobals kg,
         int node_addr_child1, traverse_mask;
         float dist[2];
         float4 cnodes = kernel_data_fetch(bvh_nodes, node_addr + 0);
+        PROFILING_BVH_TRAVERSAL_NODE();
 
         {
           traverse_mask = NODE_INTERSECT(kg,
@@ -152,6 +154,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(KernelGlobals kg,
                 {
                   /* shadow ray early termination */
                   if (visibility & PATH_RAY_SHADOW_OPAQUE) {
+                    PROFILING_BVH_TRAVERSAL_END(kg);
                     return true;
                   }
                 }
@@ -256,6 +259,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(KernelGlobals kg,
     }
   } while (node_addr != ENTRYPOINT_SENTINEL);
 
+  PROFILING_BVH_TRAVERSAL_END(kg);
   return (isect->prim != PRIM_NONE);
 }
 
@@ -344,6 +344,7 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
                                              ccl_global float *ccl_restrict render_buffer)
 {
   PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, path, bounce));
 
   /* Read ray from integrator state into local memory. */
   Ray ray ccl_optional_struct_init;
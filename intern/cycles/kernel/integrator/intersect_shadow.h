@@ -154,6 +154,7 @@ ccl_device bool integrate_intersect_shadow_transparent(KernelGlobals kg,
 ccl_device void integrator_intersect_shadow(KernelGlobals kg, IntegratorShadowState state)
 {
   PROFILING_INIT(kg, PROFILING_INTERSECT_SHADOW);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, shadow_path, bounce));
 
   /* Read ray from integrator state into local memory. */
   Ray ray ccl_optional_struct_init;
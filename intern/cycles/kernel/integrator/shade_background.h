@@ -188,6 +188,7 @@ ccl_device void integrator_shade_background(KernelGlobals kg,
                                             ccl_global float *ccl_restrict render_buffer)
 {
   PROFILING_INIT(kg, PROFILING_SHADE_LIGHT_SETUP);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, path, bounce));
 
   /* TODO: unify these in a single loop to only have a single shader evaluation call. */
   integrate_distant_lights(kg, state, render_buffer);
@@ -67,6 +67,7 @@ ccl_device void integrator_shade_light(KernelGlobals kg,
                                        ccl_global float *ccl_restrict render_buffer)
 {
   PROFILING_INIT(kg, PROFILING_SHADE_LIGHT_SETUP);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, path, bounce));
 
   integrate_light(kg, state, render_buffer);
 
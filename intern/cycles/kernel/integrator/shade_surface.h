@@ -697,6 +697,7 @@ ccl_device int integrate_surface(KernelGlobals kg,
 
 {
   PROFILING_INIT_FOR_SHADER(kg, PROFILING_SHADE_SURFACE_SETUP);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, path, bounce));
 
   /* Setup shader data. */
   ShaderData sd;
@@ -1164,6 +1164,7 @@ ccl_device void integrator_shade_volume(KernelGlobals kg,
                                         ccl_global float *ccl_restrict render_buffer)
 {
   PROFILING_INIT(kg, PROFILING_SHADE_VOLUME_SETUP);
+  PROFILING_BOUNCE(INTEGRATOR_STATE(state, path, bounce));
 
 #ifdef __VOLUME__
   /* Setup shader data. */
@@ -1182,7 +1182,23 @@ ccl_device void surface_shader_eval(KernelGlobals kg,
 #endif
   {
 #ifdef __SVM__
-    svm_eval_nodes<node_feature_mask, SHADER_TYPE_SURFACE>(kg, state, sd, buffer, path_flag);
+#  ifdef __KERNEL_CPU__
+    /* Evaluate shaders that do not use any of the optional node features with an interpreter
+     * where they are compiled out. Not done on GPUs, where extra kernel variants cost more than
+     * the smaller interpreter saves. */
+    constexpr uint optional_mask = node_feature_mask & KERNEL_FEATURE_NODE_MASK_SURFACE_OPTIONAL;
+    if (optional_mask != 0 &&
+        (kernel_data_fetch(shaders, (sd->shader & SHADER_MASK)).node_features & optional_mask) ==
+            0)
+    {
+      svm_eval_nodes<node_feature_mask & ~optional_mask, SHADER_TYPE_SURFACE>(
+          kg, state, sd, buffer, path_flag);
+    }
+    else
+#  endif
+    {
+      svm_eval_nodes<node_feature_mask, SHADER_TYPE_SURFACE>(kg, state, sd, buffer, path_flag);
+    }
 #else
     if (sd->object == OBJECT_NONE) {
       sd->closure_emission_background = make_spectrum(0.8f);
@@ -106,9 +106,11 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
   float stack[SVM_STACK_SIZE];
   Spectrum closure_weight;
   int offset = sd->shader & SHADER_MASK;
+  PROFILING_INIT_SVM(kg);
 
   while (true) {
     uint4 node = read_node(kg, &offset);
+    PROFILING_SVM_NODE(node.x);
 
     switch (node.x) {
       SVM_CASE(NODE_END)
@@ -161,6 +161,13 @@ enum {
   (KERNEL_FEATURE_NODE_VORONOI_EXTRA | KERNEL_FEATURE_NODE_BUMP | KERNEL_FEATURE_NODE_BUMP_STATE)
 #define KERNEL_FEATURE_NODE_MASK_BUMP KERNEL_FEATURE_NODE_MASK_DISPLACEMENT
 
+/* Node features that are reliably reported per shader, and can be compiled out of the SVM
+ * interpreter for shaders that do not use them. */
+#define KERNEL_FEATURE_NODE_MASK_SURFACE_OPTIONAL \
+  (KERNEL_FEATURE_NODE_BUMP | KERNEL_FEATURE_NODE_BUMP_STATE | \
+   KERNEL_FEATURE_NODE_VORONOI_EXTRA | KERNEL_FEATURE_NODE_RAYTRACE | \
+   KERNEL_FEATURE_NODE_PRINCIPLED_HAIR)
+
 /* Must be constexpr on the CPU to avoid compile errors because the state types
  * are different depending on the main, shadow or null path. For GPU we don't have
  * C++17 everywhere so need to check it. */
@@ -1735,7 +1742,9 @@ struct KernelShader {
   float cryptomatte_id;
   int flags;
   int pass_id;
-  int pad2, pad3;
+  /* KERNEL_FEATURE_NODE_* flags used by the shader graph. */
+  uint node_features;
+  int pad3;
 };
 static_assert_align(KernelShader, 16);
 
@@ -18,11 +18,25 @@ CCL_NAMESPACE_BEGIN
     ProfilingWithShaderHelper profiling_helper((ProfilingState *)&kg->profiler, event)
 #  define PROFILING_SHADER(object, shader) \
     profiling_helper.set_shader(object, (shader) & SHADER_MASK);
+#  define PROFILING_BOUNCE(bounce) profiling_helper.set_bounce(bounce)
+#  define PROFILING_INIT_SVM(kg) \
+    ProfilingSVMHelper profiling_svm_helper((ProfilingState *)&kg->profiler)
+#  define PROFILING_SVM_NODE(node) profiling_svm_helper.set_node(node)
+#  define PROFILING_BVH_TRAVERSAL_INIT() uint profiling_bvh_nodes = 0
+#  define PROFILING_BVH_TRAVERSAL_NODE() profiling_bvh_nodes++
+#  define PROFILING_BVH_TRAVERSAL_END(kg) \
+    profiling_bvh_traversal((ProfilingState *)&kg->profiler, profiling_bvh_nodes)
 #else
 #  define PROFILING_INIT(kg, event)
 #  define PROFILING_EVENT(event)
 #  define PROFILING_INIT_FOR_SHADER(kg, event)
 #  define PROFILING_SHADER(object, shader)
+#  define PROFILING_BOUNCE(bounce)
+#  define PROFILING_INIT_SVM(kg)
+#  define PROFILING_SVM_NODE(node)
+#  define PROFILING_BVH_TRAVERSAL_INIT()
+#  define PROFILING_BVH_TRAVERSAL_NODE()
+#  define PROFILING_BVH_TRAVERSAL_END(kg)
 #endif /* !__KERNEL_GPU__ */
 
 CCL_NAMESPACE_END
@@ -483,6 +483,7 @@ size_t ImageManager::add_image_slot(unique_ptr<ImageLoader> &&loader,
   img->builtin = builtin;
   img->users = 1;
   img->mem = nullptr;
+  img->budget_texture_limit = 0;
 
   images[slot] = std::move(img);
 
@@ -693,6 +694,144 @@ bool ImageManager::file_load_image(Image *img, const int texture_limit)
   return true;
 }
 
+/* Resolution of the largest image dimension after scaling down to the texture limit, using the
+ * same power of two scaling as #ImageManager::file_load_image. */
+static int image_limited_size(const ImageMetaData &metadata, const int texture_limit)
+{
+  const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  float scale_factor = 1.0f;
+  if (texture_limit > 0) {
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
+  }
+  return int(ceilf(max_size * scale_factor));
+}
+
+/* Memory used by the image when loaded with the largest dimension scaled to the given size. */
+static size_t image_memory_size(const ImageMetaData &metadata, const int size)
+{
+  size_t pixel_size;
+  switch (metadata.type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      pixel_size = sizeof(float4);
+      break;
+    case IMAGE_DATA_TYPE_FLOAT:
+      pixel_size = sizeof(float);
+      break;
+    case IMAGE_DATA_TYPE_BYTE4:
+      pixel_size = sizeof(uchar4);
+      break;
+    case IMAGE_DATA_TYPE_BYTE:
+      pixel_size = sizeof(uchar);
+      break;
+    case IMAGE_DATA_TYPE_HALF4:
+      pixel_size = sizeof(half4);
+      break;
+    case IMAGE_DATA_TYPE_HALF:
+      pixel_size = sizeof(half);
+      break;
+    case IMAGE_DATA_TYPE_USHORT4:
+      pixel_size = sizeof(ushort4);
+      break;
+    case IMAGE_DATA_TYPE_USHORT:
+      pixel_size = sizeof(uint16_t);
+      break;
+    default:
+      /* Volumes are not scaled. */
+      return metadata.byte_size;
+  }
+
+  const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  if (max_size == 0) {
+    return 0;
+  }
+  const double scale = double(size) / double(max_size);
+  const size_t width = max(size_t(metadata.width * scale), size_t(1));
+  const size_t height = max(size_t(metadata.height * scale), size_t(1));
+  const size_t depth = max(size_t(metadata.depth * scale), size_t(1));
+  return width * height * depth * pixel_size;
+}
+
+void ImageManager::device_update_texture_budget(Scene *scene)
+{
+  const size_t budget = size_t(scene->params.texture_memory_budget) * 1024 * 1024;
+  if (budget == 0) {
+    for (const unique_ptr<Image> &img : images) {
+      if (img && img->need_load) {
+        img->budget_texture_limit = 0;
+      }
+    }
+    return;
+  }
+
+  /* Reading the metadata can require opening the image files, do it in parallel like the image
+   * loading itself. */
+  TaskPool pool;
+  for (const unique_ptr<Image> &img : images) {
+    if (img && img->users != 0 && img->need_load) {
+      pool.push([this, image = img.get()] { load_image_metadata(image); });
+    }
+  }
+  pool.wait_work();
+
+  /* Memory used by images that are already loaded, and images that still need loading. */
+  size_t loaded_size = 0;
+  size_t pending_size = 0;
+  vector<Image *> pending_images;
+  for (const unique_ptr<Image> &img : images) {
+    if (!img || img->users == 0) {
+      continue;
+    }
+    if (!img->need_load) {
+      if (img->mem) {
+        loaded_size += img->mem->memory_size();
+      }
+      continue;
+    }
+
+    if (img->metadata.type >= IMAGE_DATA_TYPE_NANOVDB_FLOAT) {
+      /* Volumes can not be scaled down. */
+      pending_size += img->metadata.byte_size;
+      continue;
+    }
+
+    img->budget_texture_limit = image_limited_size(img->metadata, scene->params.texture_limit);
+    pending_size += image_memory_size(img->metadata, img->budget_texture_limit);
+    pending_images.push_back(img.get());
+  }
+
+  /* Halve the resolution of the biggest texture until everything fits. This keeps full detail
+   * for small textures, and large textures are the most likely to be sampled at a lower
+   * resolution than their own. */
+  while (loaded_size + pending_size > budget) {
+    Image *largest_image = nullptr;
+    size_t largest_size = 0;
+    for (Image *img : pending_images) {
+      const size_t size = image_memory_size(img->metadata, img->budget_texture_limit);
+      if (img->budget_texture_limit > 1 && size > largest_size) {
+        largest_image = img;
+        largest_size = size;
+      }
+    }
+    if (largest_image == nullptr) {
+      break;
+    }
+
+    /* Step down to the next power of two scale factor. */
+    largest_image->budget_texture_limit = image_limited_size(
+        largest_image->metadata, largest_image->budget_texture_limit - 1);
+    pending_size -= largest_size;
+    pending_size += image_memory_size(largest_image->metadata,
+                                      largest_image->budget_texture_limit);
+  }
+
+  if (loaded_size + pending_size > budget) {
+    VLOG_WARNING << "Image textures do not fit in the texture memory budget of "
+                 << string_human_readable_size(budget) << ".";
+  }
+}
+
 void ImageManager::device_load_image(Device *device,
                                      Scene *scene,
                                      const size_t slot,
@@ -706,7 +845,11 @@ void ImageManager::device_load_image(Device *device,
 
   progress.set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->budget_texture_limit > 0) {
+    texture_limit = (texture_limit > 0) ? min(texture_limit, img->budget_texture_limit) :
+                                          img->budget_texture_limit;
+  }
 
   load_image_metadata(img);
   const ImageDataType type = img->metadata.type;
@@ -869,6 +1012,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  device_update_texture_budget(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot].get();
@@ -949,8 +1094,16 @@ void ImageManager::collect_statistics(RenderStats *stats)
       /* Image may have been freed due to lack of users. */
       continue;
     }
-    stats->image.textures.add_entry(
-        NamedSizeEntry(image->loader->name(), image->mem->memory_size()));
+    string name = image->loader->name();
+    /* Report textures that are not resident at their full resolution. */
+    if (image->mem && image->mem->data_width < image->metadata.width) {
+      name += string_printf(" (%dx%d of %dx%d)",
+                            int(image->mem->data_width),
+                            int(image->mem->data_height),
+                            image->metadata.width,
+                            image->metadata.height);
+    }
+    stats->image.textures.add_entry(NamedSizeEntry(name, image->mem->memory_size()));
   }
 }
 
@@ -203,6 +203,10 @@ class ImageManager {
     string mem_name;
     unique_ptr<device_texture> mem;
 
+    /* Maximum resolution the image is loaded at to fit in the texture memory budget,
+     * 0 when not limited by the budget. */
+    int budget_texture_limit;
+
     int users;
     thread_mutex mutex;
   };
@@ -231,6 +235,7 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, const int texture_limit);
 
+  void device_update_texture_budget(Scene *scene);
   void device_load_image(Device *device, Scene *scene, const size_t slot, Progress &progress);
   void device_free_image(Device *device, const size_t slot);
 
@@ -9,6 +9,7 @@
 #include "scene/integrator.h"
 #include "scene/light.h"
 #include "scene/light_tree.h"
+#include "scene/light_tree_debug.h"
 #include "scene/mesh.h"
 #include "scene/object.h"
 #include "scene/scene.h"
@@ -819,6 +820,9 @@ void LightManager::device_update_tree(Device * /*unused*/,
 
   VLOG_INFO << "Use light tree with " << num_emitters << " emitters and " << light_tree.num_nodes
             << " nodes.";
+  if (root && VLOG_WORK_IS_ON) {
+    VLOG_WORK << "Light tree build statistics:\n" << light_tree_statistics(light_tree, *root);
+  }
 
   if (!use_light_linking) {
     /* Regular light tree without linking. */
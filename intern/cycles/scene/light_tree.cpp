@@ -8,6 +8,8 @@
 
 #include "util/math_fast.h"
 #include "util/progress.h"
+#include "util/tbb.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -269,11 +271,24 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, const int prim_id)
 
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, const int object_id)
 {
+  /* Create emitters for chunks of triangles in parallel, and append the chunks in order so the
+   * emitter order does not depend on scheduling. */
   const size_t mesh_num_triangles = mesh->num_triangles();
-  for (size_t i = 0; i < mesh_num_triangles; i++) {
-    if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+  const size_t num_chunks = divide_up(mesh_num_triangles, MIN_EMITTERS_PER_THREAD);
+  vector<vector<LightTreeEmitter>> chunk_emitters(num_chunks);
+
+  parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+    const size_t start = chunk * MIN_EMITTERS_PER_THREAD;
+    const size_t end = std::min<size_t>(start + MIN_EMITTERS_PER_THREAD, mesh_num_triangles);
+    for (size_t i = start; i < end; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        chunk_emitters[chunk].emplace_back(scene, i, object_id);
+      }
     }
+  });
+
+  for (vector<LightTreeEmitter> &emitters : chunk_emitters) {
+    std::move(emitters.begin(), emitters.end(), std::back_inserter(emitters_));
   }
 }
 
@@ -342,6 +357,8 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   int num_local_lights = local_lights_.size() + num_mesh_lights;
   const int num_distant_lights = distant_lights_.size();
 
+  double time_start = time_dt();
+
   /* Create a node for each mesh light, and keep track of unique mesh lights. */
   std::unordered_map<Mesh *, std::tuple<LightTreeNode *, int, int>> unique_mesh;
   uint *object_offsets = dscene->object_lookup_offset.alloc(scene->objects.size());
@@ -366,6 +383,9 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
     object_offsets[emitter.object_id] = offset_map_[mesh];
   }
 
+  time_mesh_emitters = time_dt() - time_start;
+  time_start = time_dt();
+
   /* Build a subtree for each unique mesh light. */
   parallel_for_each(unique_mesh, [this](auto &map_it) {
     LightTreeNode *node = std::get<0>(map_it.second);
@@ -376,6 +396,9 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   });
   task_pool.wait_work();
 
+  time_mesh_subtrees = time_dt() - time_start;
+  time_start = time_dt();
+
   /* Update measure. */
   parallel_for_each(mesh_lights_, [&](LightTreeEmitter &emitter) {
     Object *object = scene->objects[emitter.object_id];
@@ -406,6 +429,9 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
     emitter.root->measure = emitter.measure;
   }
 
+  time_mesh_measures = time_dt() - time_start;
+  time_start = time_dt();
+
   /* Could be different from `num_triangles` if only some triangles of an object are emissive. */
   const int num_emissive_triangles = emitters_.size();
   num_local_lights += num_emissive_triangles;
@@ -446,6 +472,8 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
   std::move(distant_lights_.begin(), distant_lights_.end(), std::back_inserter(emitters_));
 
+  time_top_level = time_dt() - time_start;
+
   return root_.get();
 }
 
@@ -513,6 +541,73 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+/* Add emitters to buckets, in parallel for large ranges. Chunks are merged in order so the result
+ * does not depend on scheduling. */
+template<typename BucketIndexFunc>
+static void fill_buckets(const LightTreeEmitter *emitters,
+                         const int start,
+                         const int end,
+                         const int min_parallel_emitters,
+                         const int chunk_size,
+                         std::array<LightTreeBucket, LightTreeBucket::num_buckets> &buckets,
+                         const BucketIndexFunc &bucket_index)
+{
+  if (end - start < min_parallel_emitters) {
+    for (int i = start; i < end; i++) {
+      buckets[bucket_index(emitters[i])].add(emitters[i]);
+    }
+    return;
+  }
+
+  const int num_chunks = divide_up(end - start, chunk_size);
+  vector<std::array<LightTreeBucket, LightTreeBucket::num_buckets>> chunk_buckets(num_chunks);
+
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * chunk_size;
+    const int chunk_end = min(chunk_start + chunk_size, end);
+    for (int i = chunk_start; i < chunk_end; i++) {
+      chunk_buckets[chunk][bucket_index(emitters[i])].add(emitters[i]);
+    }
+  });
+
+  for (const std::array<LightTreeBucket, LightTreeBucket::num_buckets> &chunk : chunk_buckets) {
+    for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+      buckets[i] = buckets[i] + chunk[i];
+    }
+  }
+}
+
+static BoundBox centroid_bounds(const LightTreeEmitter *emitters,
+                                const int start,
+                                const int end,
+                                const int min_parallel_emitters,
+                                const int chunk_size)
+{
+  BoundBox centroid_bbox = BoundBox::empty;
+  if (end - start < min_parallel_emitters) {
+    for (int i = start; i < end; i++) {
+      centroid_bbox.grow(emitters[i].centroid);
+    }
+    return centroid_bbox;
+  }
+
+  const int num_chunks = divide_up(end - start, chunk_size);
+  vector<BoundBox> chunk_bbox(num_chunks, BoundBox::empty);
+
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * chunk_size;
+    const int chunk_end = min(chunk_start + chunk_size, end);
+    for (int i = chunk_start; i < chunk_end; i++) {
+      chunk_bbox[chunk].grow(emitters[i].centroid);
+    }
+  });
+
+  for (const BoundBox &bbox : chunk_bbox) {
+    centroid_bbox.grow(bbox);
+  }
+  return centroid_bbox;
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
                              int &middle,
@@ -533,10 +628,8 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
   middle = (start + end) / 2;
 
-  BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
-  }
+  const BoundBox centroid_bbox = centroid_bounds(
+      emitters, start, end, MIN_EMITTERS_PARALLEL_BUCKETS, MIN_EMITTERS_PER_THREAD);
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
@@ -557,24 +650,31 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
       /* Degenerate case, everything in the same bucket. */
       inv_extent = FLT_MAX;
-      for (int i = start; i < end; i++) {
-        buckets[0].add(emitters[i]);
-      }
+      fill_buckets(emitters,
+                   start,
+                   end,
+                   MIN_EMITTERS_PARALLEL_BUCKETS,
+                   MIN_EMITTERS_PER_THREAD,
+                   buckets,
+                   [](const LightTreeEmitter & /*emitter*/) { return 0; });
     }
     else {
       /* Fill in buckets with emitters. */
       inv_extent = 1 / (centroid_bbox.size()[dim]);
-      for (int i = start; i < end; i++) {
-        const LightTreeEmitter *emitter = emitters + i;
-
-        /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-         * partitions. */
-        int bucket_idx = LightTreeBucket::num_buckets *
-                         (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-        bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-        buckets[bucket_idx].add(*emitter);
-      }
+      fill_buckets(emitters,
+                   start,
+                   end,
+                   MIN_EMITTERS_PARALLEL_BUCKETS,
+                   MIN_EMITTERS_PER_THREAD,
+                   buckets,
+                   [&](const LightTreeEmitter &emitter) {
+                     /* Place emitter into the appropriate bucket, where the centroid box is
+                      * split into equal partitions. */
+                     const int bucket_idx = LightTreeBucket::num_buckets *
+                                            (emitter.centroid[dim] - centroid_bbox.min[dim]) *
+                                            inv_extent;
+                     return clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+                   });
     }
 
     /* Precompute the left bucket measure cumulatively. */
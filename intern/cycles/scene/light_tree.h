@@ -405,6 +405,12 @@ class LightTree {
   /* Bitmask of receiver light sets used. Default set is always used. */
   uint64_t light_link_receiver_used = 1;
 
+  /* Time spent in the build stages, for statistics. */
+  double time_mesh_emitters = 0.0;
+  double time_mesh_subtrees = 0.0;
+  double time_mesh_measures = 0.0;
+  double time_top_level = 0.0;
+
   /* An inner node itself or its left and right child. */
   enum Child {
     self = -1,
@@ -439,6 +445,8 @@ class LightTree {
   TaskPool task_pool;
   /* Do not spawn a thread if less than this amount of emitters are to be processed. */
   enum { MIN_EMITTERS_PER_THREAD = 4096 };
+  /* Bucket emitters of a node in parallel from this amount of emitters. */
+  enum { MIN_EMITTERS_PARALLEL_BUCKETS = 65536 };
 
   void recursive_build(Child child,
                        LightTreeNode *inner,
@@ -218,6 +218,79 @@ void light_tree_plot_to_file(const Scene &scene,
   fclose(file);
 }
 
+struct LightTreeStatistics {
+  int num_inner = 0;
+  int num_leaf = 0;
+  int num_instances = 0;
+  int max_depth = 0;
+  int max_leaf_emitters = 0;
+  int64_t total_leaf_emitters = 0;
+};
+
+static void recursive_node_statistics(LightTreeStatistics &stats,
+                                      const LightTree &tree,
+                                      const LightTreeNode &node,
+                                      const int depth)
+{
+  stats.max_depth = max(stats.max_depth, depth);
+
+  if (node.is_leaf() || node.is_distant()) {
+    const LightTreeNode::Leaf &leaf = node.get_leaf();
+    stats.num_leaf++;
+    stats.max_leaf_emitters = max(stats.max_leaf_emitters, leaf.num_emitters);
+    stats.total_leaf_emitters += leaf.num_emitters;
+
+    /* Descend into mesh subtrees, counting each shared subtree only once. */
+    const LightTreeEmitter *emitters = tree.get_emitters();
+    for (int i = 0; i < leaf.num_emitters; i++) {
+      const LightTreeEmitter &emitter = emitters[leaf.first_emitter_index + i];
+      if (!emitter.is_mesh()) {
+        continue;
+      }
+      if (emitter.root->type == LIGHT_TREE_INSTANCE) {
+        stats.num_instances++;
+      }
+      else {
+        recursive_node_statistics(stats, tree, *emitter.root, depth + 1);
+      }
+    }
+    return;
+  }
+
+  if (!node.is_inner()) {
+    return;
+  }
+
+  stats.num_inner++;
+  recursive_node_statistics(
+      stats, tree, *node.get_inner().children[LightTree::left], depth + 1);
+  recursive_node_statistics(
+      stats, tree, *node.get_inner().children[LightTree::right], depth + 1);
+}
+
+string light_tree_statistics(const LightTree &tree, const LightTreeNode &root_node)
+{
+  LightTreeStatistics stats;
+  recursive_node_statistics(stats, tree, root_node, 0);
+
+  string result;
+  result += string_printf("  Emitters: %d\n", int(tree.num_emitters()));
+  result += string_printf("  Nodes: %d\n", int(tree.num_nodes));
+  result += string_printf("  Inner nodes: %d\n", stats.num_inner);
+  result += string_printf("  Leaf nodes: %d\n", stats.num_leaf);
+  result += string_printf("  Mesh instances: %d\n", stats.num_instances);
+  result += string_printf("  Maximum depth: %d\n", stats.max_depth);
+  result += string_printf("  Maximum emitters per leaf: %d\n", stats.max_leaf_emitters);
+  result += string_printf("  Average emitters per leaf: %.2f\n",
+                          (stats.num_leaf) ? double(stats.total_leaf_emitters) / stats.num_leaf :
+                                             0.0);
+  result += string_printf("  Mesh emitters time: %.4fs\n", tree.time_mesh_emitters);
+  result += string_printf("  Mesh subtrees time: %.4fs\n", tree.time_mesh_subtrees);
+  result += string_printf("  Mesh measures time: %.4fs\n", tree.time_mesh_measures);
+  result += string_printf("  Top level time: %.4fs\n", tree.time_top_level);
+  return result;
+}
+
 static string get_knode_id(const KernelLightTreeNode &knode)
 {
   return string_printf("knode@%p", &knode);
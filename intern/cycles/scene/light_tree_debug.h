@@ -22,4 +22,7 @@ void klight_tree_plot_to_file(uint root_index,
                               const KernelLightTreeNode *knodes,
                               const string &filename);
 
+/* Human-readable report of the tree shape and the time spent building it. */
+string light_tree_statistics(const LightTree &tree, const LightTreeNode &root_node);
+
 CCL_NAMESPACE_END
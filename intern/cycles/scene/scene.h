@@ -71,6 +71,9 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Memory budget for image textures in megabytes, 0 for unlimited. Textures are loaded at a
+   * lower resolution when they would not fit otherwise. */
+  int texture_memory_budget;
 
   bool background;
 
@@ -86,6 +89,7 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_memory_budget = 0;
     background = true;
   }
 
@@ -98,7 +102,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_memory_budget == params.texture_memory_budget);
   }
 
   int curve_subdivisions()
@@ -103,6 +103,7 @@ Shader::Shader() : Node(get_node_type())
   has_surface_spatial_varying = false;
   has_volume_spatial_varying = false;
   has_volume_attribute_dependency = false;
+  node_features = KERNEL_FEATURE_NODE_MASK_SURFACE;
   has_volume_connected = false;
   prev_volume_step_rate = 0.0f;
 
@@ -597,6 +598,7 @@ void ShaderManager::device_update_common(Device * /*device*/,
     /* regular shader */
     kshader->flags = flag;
     kshader->pass_id = shader->get_pass_id();
+    kshader->node_features = shader->node_features;
     kshader->constant_emission[0] = shader->emission_estimate.x;
     kshader->constant_emission[1] = shader->emission_estimate.y;
     kshader->constant_emission[2] = shader->emission_estimate.z;
@@ -117,6 +117,10 @@ class Shader : public Node {
   bool has_volume_spatial_varying;
   bool has_volume_attribute_dependency;
 
+  /* Node features used by the compiled graph, so the kernel can evaluate the shader with an
+   * interpreter specialized for just these features. */
+  uint node_features;
+
   float3 emission_estimate;
   EmissionSampling emission_sampling;
   bool emission_is_constant;
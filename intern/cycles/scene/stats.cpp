@@ -4,8 +4,11 @@
 
 #include "scene/stats.h"
 #include "scene/object.h"
+#include "scene/scene.h"
 #include "util/algorithm.h"
 
+#include "kernel/svm/types.h"
+
 #include "util/string.h"
 
 CCL_NAMESPACE_BEGIN
@@ -39,15 +42,74 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+const char *svm_node_names[] = {
+#define SHADER_NODE_TYPE(name) #name,
+#include "kernel/svm/node_types_template.h"
+};
+
+string json_escape(const string &str)
+{
+  string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      result += string_printf("\\u%04x", (unsigned int)c);
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+string json_nested_samples(const NamedNestedSampleStats &stats)
+{
+  string result = string_printf("{\"name\": \"%s\", \"total\": %.3f, \"self\": %.3f",
+                                json_escape(stats.name).c_str(),
+                                stats.sum_samples * 0.001,
+                                stats.self_samples * 0.001);
+  if (!stats.entries.empty()) {
+    result += ", \"children\": [";
+    for (size_t i = 0; i < stats.entries.size(); i++) {
+      result += (i > 0 ? ", " : "") + json_nested_samples(stats.entries[i]);
+    }
+    result += "]";
+  }
+  return result + "}";
+}
+
+string json_sample_counts(const NamedSampleCountStats &stats)
+{
+  string result = "[";
+  bool first = true;
+  for (NamedSampleCountStats::entry_map::const_reference entry : stats.entries) {
+    const NamedSampleCountPair &pair = entry.second;
+    result += string_printf("%s{\"name\": \"%s\", \"time\": %.3f, \"hits\": %llu}",
+                            first ? "" : ", ",
+                            json_escape(pair.name.string()).c_str(),
+                            pair.samples * 0.001,
+                            (unsigned long long)pair.hits);
+    first = false;
+  }
+  return result + "]";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : size(0) {}
 
 NamedSizeEntry::NamedSizeEntry(const string &name, const size_t size) : name(name), size(size) {}
 
-NamedTimeEntry::NamedTimeEntry() : time(0) {}
+NamedTimeEntry::NamedTimeEntry() : time(0), is_part_of_other(false) {}
 
-NamedTimeEntry::NamedTimeEntry(const string &name, const double time) : name(name), time(time) {}
+NamedTimeEntry::NamedTimeEntry(const string &name, const double time, const bool is_part_of_other)
+    : name(name), time(time), is_part_of_other(is_part_of_other)
+{
+}
 
 /* Named size statistics. */
 
@@ -87,8 +149,11 @@ string NamedTimeStats::full_report(const int indent_level)
   result += string_printf("%sTotal time: %fs\n", indent.c_str(), total_time);
   sort(entries.begin(), entries.end(), namedTimeEntryComparator);
   for (const NamedTimeEntry &entry : entries) {
-    result += string_printf(
-        "%s%-40s %fs\n", double_indent.c_str(), entry.name.c_str(), entry.time);
+    result += string_printf("%s%-40s %fs%s\n",
+                            double_indent.c_str(),
+                            entry.name.c_str(),
+                            entry.time,
+                            entry.is_part_of_other ? " (not in total)" : "");
   }
   return result;
 }
@@ -230,6 +295,7 @@ string ImageStats::full_report(const int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  has_bvh_traversals = false;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -285,6 +351,63 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
       objects.add(object->name, samples, hits);
     }
   }
+
+  svm_nodes = NamedNestedSampleStats("SVM nodes", 0);
+  for (int i = 0; i < NODE_NUM; i++) {
+    const uint64_t samples = prof.get_svm_node(i);
+    if (samples) {
+      svm_nodes.add_entry(svm_node_names[i], samples);
+    }
+  }
+
+  bounces = NamedNestedSampleStats("Bounces", 0);
+  for (int i = 0; i < PROFILING_NUM_BOUNCES; i++) {
+    const uint64_t samples = prof.get_bounce(i);
+    if (samples) {
+      const bool is_last = (i == PROFILING_NUM_BOUNCES - 1);
+      bounces.add_entry(string_printf("Bounce %d%s", i, is_last ? "+" : ""), samples);
+    }
+  }
+
+  has_bvh_traversals = (scene->dscene.data.bvh.bvh_layout == BVH_LAYOUT_BVH2);
+  bvh_traversals.resize(PROFILING_NUM_BVH_BUCKETS);
+  for (int i = 0; i < PROFILING_NUM_BVH_BUCKETS; i++) {
+    bvh_traversals[i] = prof.get_bvh_traversal(i);
+  }
+}
+
+string RenderStats::bvh_traversal_report(const int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+
+  if (!has_bvh_traversals) {
+    return indent + "Not available, only recorded for the BVH2 layout\n";
+  }
+
+  uint64_t total = 0;
+  for (const uint64_t count : bvh_traversals) {
+    total += count;
+  }
+  if (total == 0) {
+    return indent + "No BVH traversals recorded\n";
+  }
+
+  string result = indent + string_printf("Total traversals: %s\n",
+                                         string_human_readable_number(total).c_str());
+  for (int i = 0; i < bvh_traversals.size(); i++) {
+    if (bvh_traversals[i] == 0) {
+      continue;
+    }
+    const bool is_last = (i == bvh_traversals.size() - 1);
+    const string range = is_last ? string_printf("%u+", 1u << i) :
+                                   string_printf("%u-%u", i ? 1u << i : 0u, (2u << i) - 1);
+    result += indent + indent +
+              string_printf("%-16s nodes: %3.2f%% (%s)\n",
+                            range.c_str(),
+                            100.0 * bvh_traversals[i] / total,
+                            string_human_readable_number(bvh_traversals[i]).c_str());
+  }
+  return result;
 }
 
 string RenderStats::full_report()
@@ -296,6 +419,9 @@ string RenderStats::full_report()
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
+    result += "SVM node statistics:\n" + svm_nodes.full_report(1);
+    result += "Bounce statistics:\n" + bounces.full_report(1);
+    result += "BVH traversal statistics:\n" + bvh_traversal_report(1);
   }
   else {
     result += "Profiling information not available (only works with CPU rendering)";
@@ -303,6 +429,37 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  if (!has_profiling) {
+    return "{}\n";
+  }
+
+  kernel.update_sum();
+  svm_nodes.update_sum();
+  bounces.update_sum();
+
+  string result = "{\n";
+  result += "  \"kernel\": " + json_nested_samples(kernel) + ",\n";
+  result += "  \"shaders\": " + json_sample_counts(shaders) + ",\n";
+  result += "  \"objects\": " + json_sample_counts(objects) + ",\n";
+  result += "  \"svm_nodes\": " + json_nested_samples(svm_nodes) + ",\n";
+  result += "  \"bounces\": " + json_nested_samples(bounces) + ",\n";
+  result += "  \"bvh_traversal_nodes\": ";
+  if (has_bvh_traversals) {
+    result += "[";
+    for (int i = 0; i < bvh_traversals.size(); i++) {
+      result += string_printf("%s%llu", i ? ", " : "", (unsigned long long)bvh_traversals[i]);
+    }
+    result += "]";
+  }
+  else {
+    result += "null";
+  }
+  result += "\n}\n";
+  return result;
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
 string UpdateTimeStats::full_report(const int indent_level)
@@ -315,6 +472,7 @@ SceneUpdateStats::SceneUpdateStats() = default;
 string SceneUpdateStats::full_report()
 {
   string result;
+  result += "Sync:\n" + sync.full_report(1);
   result += "Scene:\n" + scene.full_report(1);
   result += "Geometry:\n" + geometry.full_report(1);
   result += "Light:\n" + light.full_report(1);
@@ -30,10 +30,13 @@ class NamedSizeEntry {
 class NamedTimeEntry {
  public:
   NamedTimeEntry();
-  NamedTimeEntry(const string &name, const double time);
+  NamedTimeEntry(const string &name, const double time, const bool is_part_of_other = false);
 
   string name;
   double time;
+  /* The time is already included in another entry, so it is reported without being added to the
+   * total time. */
+  bool is_part_of_other;
 };
 
 /* Container of named size entries. Used, for example, to store per-mesh memory
@@ -66,7 +69,9 @@ class NamedTimeStats {
   /* Add entry to the statistics. */
   void add_entry(const NamedTimeEntry &entry)
   {
-    total_time += entry.time;
+    if (!entry.is_part_of_other) {
+      total_time += entry.time;
+    }
     entries.push_back(entry);
   }
 
@@ -167,6 +172,9 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return profiling information as a JSON document, for consumption by external tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -177,6 +185,16 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+  NamedNestedSampleStats svm_nodes;
+  NamedNestedSampleStats bounces;
+
+  /* Histogram of BVH nodes visited per traversal, see PROFILING_NUM_BVH_BUCKETS. Only recorded by
+   * the built-in BVH2 traversal, not by Embree. */
+  bool has_bvh_traversals;
+  vector<uint64_t> bvh_traversals;
+
+ protected:
+  string bvh_traversal_report(const int indent_level);
 };
 
 class UpdateTimeStats {
@@ -191,6 +209,10 @@ class SceneUpdateStats {
  public:
   SceneUpdateStats();
 
+  /* Synchronization from the host application. It happens before the device update, so it is
+   * reset by the synchronization itself rather than by clear(). */
+  UpdateTimeStats sync;
+
   UpdateTimeStats geometry;
   UpdateTimeStats image;
   UpdateTimeStats light;
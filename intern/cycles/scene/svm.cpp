@@ -945,6 +945,15 @@ void SVMCompiler::compile(Shader *shader,
     svm_nodes.append(current_svm_nodes);
   }
 
+  /* Gather node features after the graph is finalized, since finalizing adds bump nodes. */
+  shader->node_features = scene->shader_manager->get_graph_kernel_features(shader->graph.get());
+  if (has_bump) {
+    shader->node_features |= KERNEL_FEATURE_NODE_BUMP;
+    if (shader->get_displacement_method() == DISPLACE_BOTH) {
+      shader->node_features |= KERNEL_FEATURE_NODE_BUMP_STATE;
+    }
+  }
+
   /* Fill in summary information. */
   if (summary != nullptr) {
     summary->time_total = time_dt() - time_start;
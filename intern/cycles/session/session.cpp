@@ -7,6 +7,7 @@
 #include "device/cpu/device.h"
 #include "device/device.h"
 #include "integrator/path_trace.h"
+#include "kernel/svm/types.h"
 #include "scene/background.h"
 #include "scene/camera.h"
 #include "scene/integrator.h"
@@ -422,7 +423,7 @@ RenderWork Session::run_update_for_next_iteration()
     }
 
     if (update_scene(width, height)) {
-      profiler.reset(scene->shaders.size(), scene->objects.size());
+      profiler.reset(scene->shaders.size(), scene->objects.size(), NODE_NUM);
     }
 
     /* Unlock scene mutex before loading denoiser kernels, since that may attempt to activate
@@ -96,7 +96,8 @@ class SessionParams {
   {
     /* Modified means we have to recreate the session, any parameter changes
      * that can be handled by an existing Session are omitted. */
-    return !(device == params.device && headless == params.headless &&
+    return !(device == params.device && device.use_numa == params.device.use_numa &&
+             headless == params.headless &&
              background == params.background && experimental == params.experimental &&
              pixel_size == params.pixel_size && threads == params.threads &&
              use_profiling == params.use_profiling && shadingsystem == params.shadingsystem &&
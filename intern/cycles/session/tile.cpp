@@ -625,30 +625,109 @@ void TileManager::finish_write_tiles()
   write_state_.filename = "";
 }
 
-bool TileManager::read_full_buffer_from_disk(const string_view filename,
-                                             RenderBuffers *buffers,
-                                             DenoiseParams *denoise_params)
+/* Open tile file and read buffer and denoise parameters from its attributes.
+ * The denoise parameters are optional. */
+static unique_ptr<ImageInput> open_full_buffer_file(const string_view filename,
+                                                    BufferParams *buffer_params,
+                                                    DenoiseParams *denoise_params)
 {
   unique_ptr<ImageInput> in(ImageInput::open(filename));
   if (!in) {
     LOG(ERROR) << "Error opening tile file " << filename;
-    return false;
+    return nullptr;
   }
 
   const ImageSpec &image_spec = in->spec();
 
-  BufferParams buffer_params;
-  if (!buffer_params_from_image_spec_atttributes(&buffer_params, image_spec)) {
+  if (!buffer_params_from_image_spec_atttributes(buffer_params, image_spec)) {
+    return nullptr;
+  }
+
+  if (denoise_params &&
+      !node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX))
+  {
+    return nullptr;
+  }
+
+  return in;
+}
+
+bool TileManager::read_full_buffer_params_from_disk(const string_view filename,
+                                                    BufferParams *buffer_params,
+                                                    DenoiseParams *denoise_params)
+{
+  unique_ptr<ImageInput> in = open_full_buffer_file(filename, buffer_params, denoise_params);
+  if (!in) {
     return false;
   }
-  buffers->reset(buffer_params);
 
-  if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+  if (!in->close()) {
+    LOG(ERROR) << "Error closing tile file " << in->geterror();
     return false;
   }
 
-  const int num_channels = in->spec().nchannels;
-  if (!in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, buffers->buffer.data())) {
+  return true;
+}
+
+bool TileManager::read_full_buffer_rows_from_disk(const string_view filename,
+                                                  const int y,
+                                                  const int height,
+                                                  const int overlap,
+                                                  RenderBuffers *buffers)
+{
+  BufferParams buffer_params;
+  unique_ptr<ImageInput> in = open_full_buffer_file(filename, &buffer_params, nullptr);
+  if (!in) {
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+
+  /* Tiled files can only be read at the tile boundaries, so expand the overlap region to the
+   * closest tile rows. */
+  const int row_alignment = max(image_spec.tile_height, 1);
+  const int read_y = max(y - overlap, 0) / row_alignment * row_alignment;
+  const int read_y_end = min(int(align_up(y + height + overlap, row_alignment)),
+                             buffer_params.height);
+
+  /* Rows which are read from the file but are outside of the requested range are only used as
+   * a context for the denoiser, and are kept outside of the window. */
+  BufferParams rows_params = buffer_params;
+  rows_params.full_y = buffer_params.full_y + read_y;
+  rows_params.height = read_y_end - read_y;
+  rows_params.window_y = y - read_y;
+  rows_params.window_height = height;
+  buffers->reset(rows_params);
+
+  const int num_channels = image_spec.nchannels;
+  bool success;
+  if (image_spec.tile_width) {
+    success = in->read_tiles(0,
+                             0,
+                             image_spec.x,
+                             image_spec.x + image_spec.width,
+                             image_spec.y + read_y,
+                             image_spec.y + read_y_end,
+                             0,
+                             1,
+                             0,
+                             num_channels,
+                             TypeDesc::FLOAT,
+                             buffers->buffer.data());
+  }
+  else {
+    success = in->read_scanlines(0,
+                                 0,
+                                 image_spec.y + read_y,
+                                 image_spec.y + read_y_end,
+                                 0,
+                                 0,
+                                 num_channels,
+                                 TypeDesc::FLOAT,
+                                 buffers->buffer.data());
+  }
+
+  if (!success) {
     LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
     return false;
   }
@@ -77,6 +77,11 @@ class TileManager {
     return overscan_;
   }
 
+  int2 get_tile_size() const
+  {
+    return tile_size_;
+  }
+
   bool next();
   bool done();
 
@@ -100,12 +105,27 @@ class TileManager {
     return write_state_.num_tiles_written != 0;
   }
 
-  /* Read full frame render buffer from tiles file on disk.
+  /* Read parameters of the full frame render buffer stored in the tiles file on disk, without
+   * reading any pixels.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_params_from_disk(string_view filename,
+                                         BufferParams *buffer_params,
+                                         DenoiseParams *denoise_params);
+
+  /* Read rows [y, y + height) of the full frame render buffer from tiles file on disk.
+   *
+   * At least `overlap` rows above and below the range are read as well (when they exist), and
+   * the window of the buffers is set to the requested rows. This allows to process the full
+   * frame in bands which are denoised with a context of the neighbor pixels, while keeping the
+   * memory usage independent from the frame resolution.
    *
    * Returns true on success. */
-  bool read_full_buffer_from_disk(string_view filename,
-                                  RenderBuffers *buffers,
-                                  DenoiseParams *denoise_params);
+  bool read_full_buffer_rows_from_disk(string_view filename,
+                                       int y,
+                                       int height,
+                                       int overlap,
+                                       RenderBuffers *buffers);
 
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
@@ -32,6 +32,7 @@ void DebugFlags::CPU::reset()
 #undef CHECK_CPU_FLAGS
 
   bvh_layout = BVH_LAYOUT_AUTO;
+  wavefront = false;
 }
 
 DebugFlags::CUDA::CUDA()
@@ -45,6 +45,10 @@ class DebugFlags {
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout = BVH_LAYOUT_AUTO;
+
+    /* Use wavefront path tracing, where the paths of a batch of pixels are advanced together and
+     * grouped by the kernel they execute next, instead of tracing one path at a time. */
+    bool wavefront = false;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
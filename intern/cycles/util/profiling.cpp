@@ -28,6 +28,8 @@ void Profiler::run()
       const uint32_t cur_event = state->event;
       const int32_t cur_shader = state->shader;
       const int32_t cur_object = state->object;
+      const int32_t cur_svm_node = state->svm_node;
+      const int32_t cur_bounce = state->bounce;
 
       /* The state reads/writes should be atomic, but just to be sure
        * check the values for validity anyways. */
@@ -42,6 +44,14 @@ void Profiler::run()
       if (cur_object >= 0 && cur_object < object_samples.size()) {
         object_samples[cur_object]++;
       }
+
+      if (cur_svm_node >= 0 && cur_svm_node < svm_node_samples.size()) {
+        svm_node_samples[cur_svm_node]++;
+      }
+
+      if (cur_bounce >= 0) {
+        bounce_samples[std::min(int(cur_bounce), PROFILING_NUM_BOUNCES - 1)]++;
+      }
     }
     lock.unlock();
 
@@ -54,7 +64,7 @@ void Profiler::run()
   }
 }
 
-void Profiler::reset(const int num_shaders, const int num_objects)
+void Profiler::reset(const int num_shaders, const int num_objects, const int num_svm_nodes)
 {
   const bool running = (worker != nullptr);
   if (running) {
@@ -64,10 +74,13 @@ void Profiler::reset(const int num_shaders, const int num_objects)
   /* Resize and clear the accumulation vectors. */
   shader_hits.assign(num_shaders, 0);
   object_hits.assign(num_objects, 0);
+  bvh_traversal_hits.assign(PROFILING_NUM_BVH_BUCKETS, 0);
 
   event_samples.assign(PROFILING_NUM_EVENTS, 0);
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
+  svm_node_samples.assign(num_svm_nodes, 0);
+  bounce_samples.assign(PROFILING_NUM_BOUNCES, 0);
 
   if (running) {
     start();
@@ -102,11 +115,14 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->bvh_traversal_hits.assign(PROFILING_NUM_BVH_BUCKETS, 0);
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
   state->shader = -1;
   state->object = -1;
+  state->svm_node = -1;
+  state->bounce = -1;
   state->active = true;
 }
 
@@ -128,6 +144,11 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  assert(bvh_traversal_hits.size() == state->bvh_traversal_hits.size());
+  for (int i = 0; i < bvh_traversal_hits.size(); i++) {
+    bvh_traversal_hits[i] += state->bvh_traversal_hits[i];
+  }
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -158,6 +179,24 @@ bool Profiler::get_object(const int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+uint64_t Profiler::get_svm_node(const int svm_node)
+{
+  assert(worker == nullptr);
+  return svm_node_samples[svm_node];
+}
+
+uint64_t Profiler::get_bounce(const int bounce)
+{
+  assert(worker == nullptr);
+  return bounce_samples[bounce];
+}
+
+uint64_t Profiler::get_bvh_traversal(const int bucket)
+{
+  assert(worker == nullptr);
+  return bvh_traversal_hits[bucket];
+}
+
 bool Profiler::active() const
 {
   return (worker != nullptr);
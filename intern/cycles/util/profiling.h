@@ -45,6 +45,14 @@ enum ProfilingEvent : uint32_t {
   PROFILING_NUM_EVENTS,
 };
 
+/* Number of path bounces tracked separately, deeper bounces are accumulated in the last one. */
+constexpr int PROFILING_NUM_BOUNCES = 32;
+
+/* Number of buckets of the histogram of BVH nodes visited per ray traversal. Bucket i counts
+ * traversals which visited [2^i, 2^(i+1)) nodes, except for the first one which also counts
+ * traversals without any node visited, and the last one which counts everything above. */
+constexpr int PROFILING_NUM_BVH_BUCKETS = 16;
+
 /* Contains the current execution state of a worker thread.
  * These values are constantly updated by the worker.
  * Periodically the profiler thread will wake up, read them
@@ -62,10 +70,13 @@ struct ProfilingState {
   volatile uint32_t event = PROFILING_UNKNOWN;
   volatile int32_t shader = -1;
   volatile int32_t object = -1;
+  volatile int32_t svm_node = -1;
+  volatile int32_t bounce = -1;
   volatile bool active = false;
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+  vector<uint64_t> bvh_traversal_hits;
 };
 
 class Profiler {
@@ -73,7 +84,7 @@ class Profiler {
   Profiler();
   ~Profiler();
 
-  void reset(const int num_shaders, const int num_objects);
+  void reset(const int num_shaders, const int num_objects, const int num_svm_nodes);
 
   void start();
   void stop();
@@ -84,6 +95,9 @@ class Profiler {
   uint64_t get_event(ProfilingEvent event);
   bool get_shader(const int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(const int object, uint64_t &samples, uint64_t &hits);
+  uint64_t get_svm_node(const int svm_node);
+  uint64_t get_bounce(const int bounce);
+  uint64_t get_bvh_traversal(const int bucket);
 
   bool active() const;
 
@@ -96,6 +110,8 @@ class Profiler {
   vector<uint64_t> event_samples;
   vector<uint64_t> shader_samples;
   vector<uint64_t> object_samples;
+  vector<uint64_t> svm_node_samples;
+  vector<uint64_t> bounce_samples;
 
   /* Tracks the total amounts every object/shader was hit.
    * Used to evaluate relative cost, written by the render thread.
@@ -104,6 +120,10 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Histogram of the number of BVH nodes visited per ray traversal, see
+   * PROFILING_NUM_BVH_BUCKETS. */
+  vector<uint64_t> bvh_traversal_hits;
+
   volatile bool do_stop_worker;
   unique_ptr<thread> worker;
 
@@ -116,12 +136,14 @@ class ProfilingHelper {
   ProfilingHelper(ProfilingState *state, ProfilingEvent event) : state(state)
   {
     previous_event = state->event;
+    previous_bounce = state->bounce;
     state->event = event;
   }
 
   ~ProfilingHelper()
   {
     state->event = previous_event;
+    state->bounce = previous_bounce;
   }
 
   void set_event(ProfilingEvent event)
@@ -129,9 +151,15 @@ class ProfilingHelper {
     state->event = event;
   }
 
+  void set_bounce(const int bounce)
+  {
+    state->bounce = bounce;
+  }
+
  protected:
   ProfilingState *state;
   uint32_t previous_event;
+  int32_t previous_bounce;
 };
 
 class ProfilingWithShaderHelper : public ProfilingHelper {
@@ -166,4 +194,41 @@ class ProfilingWithShaderHelper : public ProfilingHelper {
   }
 };
 
+class ProfilingSVMHelper {
+ public:
+  /* Set once per shader evaluation, so that every node only pays for a predictable branch instead
+   * of a store to the shared state when the profiler is not running. */
+  explicit ProfilingSVMHelper(ProfilingState *state) : state(state), active(state->active) {}
+
+  ~ProfilingSVMHelper()
+  {
+    if (active) {
+      state->svm_node = -1;
+    }
+  }
+
+  void set_node(const int svm_node)
+  {
+    if (active) {
+      state->svm_node = svm_node;
+    }
+  }
+
+ protected:
+  ProfilingState *state;
+  bool active;
+};
+
+/* Count a BVH traversal which visited the given number of nodes. */
+inline void profiling_bvh_traversal(ProfilingState *state, const uint num_nodes)
+{
+  if (state->active) {
+    int bucket = 0;
+    for (uint n = num_nodes >> 1; n && bucket < PROFILING_NUM_BVH_BUCKETS - 1; n >>= 1) {
+      bucket++;
+    }
+    state->bvh_traversal_hits[bucket]++;
+  }
+}
+
 CCL_NAMESPACE_END
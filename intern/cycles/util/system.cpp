@@ -16,6 +16,7 @@
 #  include <sys/types.h>
 #  include <unistd.h>
 #else
+#  include <sched.h>
 #  include <sys/ioctl.h>
 #  include <unistd.h>
 #endif
@@ -254,4 +255,36 @@ uint64_t system_self_process_id()
 #endif
 }
 
+bool system_self_process_set_cpu_affinity(const int first_cpu, const int num_cpus)
+{
+  if (first_cpu < 0 || num_cpus <= 0) {
+    return false;
+  }
+
+#ifdef _WIN32
+  /* Only the first processor group is supported. */
+  if (first_cpu + num_cpus > int(sizeof(DWORD_PTR) * 8)) {
+    return false;
+  }
+  DWORD_PTR mask = 0;
+  for (int cpu = first_cpu; cpu < first_cpu + num_cpus; cpu++) {
+    mask |= DWORD_PTR(1) << cpu;
+  }
+  return SetProcessAffinityMask(GetCurrentProcess(), mask) != 0;
+#elif defined(__linux__)
+  if (first_cpu + num_cpus > CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu = first_cpu; cpu < first_cpu + num_cpus; cpu++) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  /* macOS has no API for explicit CPU affinity. */
+  return false;
+#endif
+}
+
 CCL_NAMESPACE_END
@@ -24,4 +24,9 @@ size_t system_physical_ram();
 /* Get identifier of the currently running process. */
 uint64_t system_self_process_id();
 
+/* Restrict the currently running process and all its future threads to the CPU threads
+ * [first_cpu, first_cpu + num_cpus).
+ * Returns false if the affinity could not be set or is not supported on this platform. */
+bool system_self_process_set_cpu_affinity(int first_cpu, int num_cpus);
+
 CCL_NAMESPACE_END
@@ -13,6 +13,7 @@
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
+#include <tbb/parallel_invoke.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/task_arena.h>
 #include <tbb/task_group.h>
@@ -23,12 +24,21 @@
 #  include <tbb/global_control.h>
 #endif
 
+/* NUMA topology is only available with oneTBB, and at runtime requires the TBBBind library. */
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+#  define WITH_TBB_NUMA
+#  include <tbb/info.h>
+#endif
+
+#include <vector>
+
 CCL_NAMESPACE_BEGIN
 
 using tbb::blocked_range;
 using tbb::enumerable_thread_specific;
 using tbb::parallel_for;
 using tbb::parallel_for_each;
+using tbb::parallel_invoke;
 using tbb::parallel_reduce;
 
 static inline void thread_capture_fp_settings()
@@ -43,6 +53,43 @@ static inline void thread_capture_fp_settings()
   }
 }
 
+/* Get identifiers of the NUMA nodes of the system. Returns a single automatic node when the
+ * topology is not known. */
+static inline std::vector<int> tbb_numa_nodes()
+{
+#ifdef WITH_TBB_NUMA
+  std::vector<tbb::numa_node_id> nodes = tbb::info::numa_nodes();
+  return std::vector<int>(nodes.begin(), nodes.end());
+#else
+  return {tbb::task_arena::automatic};
+#endif
+}
+
+/* Get number of threads of the given NUMA node. */
+static inline int tbb_numa_node_concurrency(const int node)
+{
+#ifdef WITH_TBB_NUMA
+  return tbb::info::default_concurrency(node);
+#else
+  (void)node;
+  return tbb::this_task_arena::max_concurrency();
+#endif
+}
+
+/* Create arena with the given number of threads, all of them bound to the given NUMA node.
+ * No slot is reserved for the calling thread, so that all threads of the node are used even
+ * while the calling thread is waiting on another arena. */
+static inline tbb::task_arena tbb_numa_arena_create(const int node, const int num_threads)
+{
+#ifdef WITH_TBB_NUMA
+  tbb::task_arena::constraints constraints(node, num_threads);
+  return tbb::task_arena(constraints, 0);
+#else
+  (void)node;
+  return tbb::task_arena(num_threads);
+#endif
+}
+
 static inline void parallel_for_cancel()
 {
 #if TBB_INTERFACE_VERSION_MAJOR >= 12
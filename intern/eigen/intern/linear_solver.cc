@@ -23,6 +23,7 @@
 using EigenSparseMatrix = Eigen::SparseMatrix<double, Eigen::ColMajor>;
 using EigenSparseLU = Eigen::SparseLU<EigenSparseMatrix>;
 using EigenVectorX = Eigen::VectorXd;
+using EigenMatrixX = Eigen::MatrixXd;
 using EigenTriplet = Eigen::Triplet<double>;
 
 /* Linear Solver data structure */
@@ -301,36 +302,45 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   }
 
   if (result) {
-    /* solve for each right hand side */
-    for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
-      /* modify for locked variables */
-      EigenVectorX &b = solver->b[rhs];
+    /* modify for locked variables */
+    for (int i = 0; i < solver->num_variables; i++) {
+      LinearSolver::Variable *variable = &solver->variable[i];
 
-      for (int i = 0; i < solver->num_variables; i++) {
-        LinearSolver::Variable *variable = &solver->variable[i];
+      if (variable->locked) {
+        std::vector<LinearSolver::Coeff> &a = variable->a;
 
-        if (variable->locked) {
-          std::vector<LinearSolver::Coeff> &a = variable->a;
+        for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
+          EigenVectorX &b = solver->b[rhs];
 
           for (int j = 0; j < a.size(); j++) {
             b[a[j].index] -= a[j].value * variable->value[rhs];
           }
         }
       }
+    }
 
-      /* solve */
-      if (solver->least_squares) {
-        EigenVectorX Mtb = solver->M.transpose() * b;
-        solver->x[rhs] = solver->sparseLU->solve(Mtb);
-      }
-      else {
-        EigenVectorX &b = solver->b[rhs];
-        solver->x[rhs] = solver->sparseLU->solve(b);
-      }
+    /* Solve all right hand sides at once. The factorization is shared, and the supernodal
+     * triangular solves then work on dense blocks instead of one vector at a time. */
+    EigenMatrixX B(solver->m, solver->num_rhs);
+    for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
+      B.col(rhs) = solver->b[rhs];
+    }
 
-      if (solver->sparseLU->info() != Eigen::Success) {
-        result = false;
-      }
+    EigenMatrixX X;
+    if (solver->least_squares) {
+      EigenMatrixX MtB = solver->M.transpose() * B;
+      X = solver->sparseLU->solve(MtB);
+    }
+    else {
+      X = solver->sparseLU->solve(B);
+    }
+
+    if (solver->sparseLU->info() != Eigen::Success) {
+      result = false;
+    }
+
+    for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
+      solver->x[rhs] = X.col(rhs);
     }
 
     if (result) {
@@ -181,6 +181,12 @@ struct Global {
   char gpu_debug_scope_name[200];
 
   bool profile_gpu;
+
+  /**
+   * Write a profile of the compositor evaluation to this file when rendering.
+   * Set using `--profile-compositor <path>`, empty when disabled.
+   */
+  char profile_compositor_filepath[/*FILE_MAX*/ 1024];
 };
 
 /* **************** GLOBAL ********************* */
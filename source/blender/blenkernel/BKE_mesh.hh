@@ -89,6 +89,15 @@ void normals_calc_faces(Span<float3> vert_positions,
                         Span<int> corner_verts,
                         MutableSpan<float3> face_normals);
 
+/**
+ * Recalculate the normals of the selected faces only, leaving the others unchanged.
+ */
+void normals_calc_faces(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals);
+
 /**
  * Calculate vertex normals directly into the result array.
  *
@@ -105,6 +114,17 @@ void normals_calc_verts(Span<float3> vert_positions,
                         Span<float3> face_normals,
                         MutableSpan<float3> vert_normals);
 
+/**
+ * Recalculate the normals of the selected vertices only, leaving the others unchanged.
+ */
+void normals_calc_verts(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        GroupedSpan<int> vert_to_face_map,
+                        Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -86,6 +86,14 @@ Mesh *mesh_create_eval_no_deform_render(Depsgraph *depsgraph,
 
 void mesh_eval_to_meshkey(const Mesh *me_deformed, Mesh *mesh, KeyBlock *kb);
 
+/**
+ * When only deform modifiers are evaluated (e.g. an armature pose changed), the new evaluated mesh
+ * has the same topology as the previous one and topology caches are already shared through the
+ * input mesh. Reuse the position dependent caches of the previous result whose other inputs are
+ * unchanged, and only update the normals for the vertices that actually moved.
+ */
+void mesh_reuse_deformed_caches(Mesh &mesh_prev, Mesh &mesh);
+
 }  // namespace blender::bke
 
 #ifndef NDEBUG
@@ -0,0 +1,191 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.hh"
+#include "BLI_string.h"
+
+#include "BKE_action.hh"
+#include "BKE_armature.hh"
+#include "BKE_deform.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+#include "BKE_object.hh"
+#include "BKE_object_types.hh"
+
+#include "DNA_armature_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "CLG_log.h"
+
+namespace blender::bke::tests {
+
+/**
+ * Deform a mesh with a posed armature of three bones. Passing deform matrices makes the armature
+ * deform use its generic per vertex code, the linear blend skinning fast path only handles
+ * positions, so the results of both can be compared.
+ */
+class ArmatureDeformTest : public ::testing::Test {
+ public:
+  Main *bmain;
+  Object *ob_arm;
+  Object *ob_mesh;
+  Mesh *mesh;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    ob_arm = BKE_object_add_only_object(bmain, OB_ARMATURE, "Armature");
+    bArmature *arm = BKE_armature_add(bmain, "Armature");
+    ob_arm->data = arm;
+    const char *names[3] = {"Root", "Arm", "Hand"};
+    for (const int i : IndexRange(3)) {
+      Bone *bone = MEM_cnew<Bone>("Bone");
+      STRNCPY(bone->name, names[i]);
+      bone->head[0] = float(i);
+      bone->tail[0] = float(i) + 1.0f;
+      bone->tail[1] = 0.2f;
+      BLI_addtail(&arm->bonebase, bone);
+    }
+    BKE_armature_where_is(arm);
+    BKE_pose_ensure(bmain, ob_arm, arm, false);
+    ob_arm->runtime->object_to_world = math::from_location<float4x4>(float3(0.5f, -1.0f, 2.0f));
+
+    int i = 0;
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      const float loc[3] = {0.1f * i, -0.3f, 0.2f * i};
+      const float eul[3] = {0.4f, -0.2f * i, 0.7f + i};
+      const float size[3] = {1.0f, 1.0f + 0.1f * i, 0.9f};
+      loc_eul_size_to_mat4(pchan->chan_mat, loc, eul, size);
+      mat4_to_dquat(&pchan->runtime.deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
+      i++;
+    }
+
+    ob_mesh = BKE_object_add_only_object(bmain, OB_MESH, "Mesh");
+    mesh = BKE_mesh_new_nomain(64, 0, 0, 0);
+    ob_mesh->data = mesh;
+    ob_mesh->runtime->object_to_world = math::from_location<float4x4>(float3(0.0f, 1.0f, 0.0f));
+    for (const char *name : names) {
+      BKE_object_defgroup_new(ob_mesh, name);
+    }
+    /* A vertex group without a bone. */
+    BKE_object_defgroup_new(ob_mesh, "Other");
+
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    for (const int vert : positions.index_range()) {
+      positions[vert] = float3(vert * 0.05f, math::sin(vert * 0.3f), math::cos(vert * 0.2f));
+    }
+  }
+
+  void TearDown() override
+  {
+    ob_mesh->data = nullptr;
+    BKE_id_free(nullptr, mesh);
+    BKE_main_free(bmain);
+  }
+
+  /** Assign one to three weights to each vertex, optionally scaled so they don't add up to 1. */
+  void assign_weights(const bool normalized)
+  {
+    MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+    for (const int vert : dverts.index_range()) {
+      MDeformVert &dvert = dverts[vert];
+      if (vert % 11 == 5) {
+        /* Not deformed. */
+        continue;
+      }
+      const int groups_num = 1 + vert % 3;
+      const float scale = normalized ? 1.0f : 0.3f + 0.1f * (vert % 15);
+      for (const int i : IndexRange(groups_num)) {
+        BKE_defvert_add_index_notest(
+            &dvert, (vert + i) % 4, scale * (i + 1) / (groups_num * (groups_num + 1) / 2.0f));
+      }
+      if (vert % 7 == 0) {
+        BKE_defvert_add_index_notest(&dvert, vert % 3, 0.0f);
+      }
+    }
+  }
+
+  Array<float3> deform(const int deformflag, const bool use_deform_mats)
+  {
+    Array<float3> positions(mesh->vert_positions());
+    Array<float3x3> deform_mats(positions.size(), float3x3::identity());
+    BKE_armature_deform_coords_with_mesh(
+        ob_arm,
+        ob_mesh,
+        reinterpret_cast<float(*)[3]>(positions.data()),
+        use_deform_mats ? reinterpret_cast<float(*)[3][3]>(deform_mats.data()) : nullptr,
+        positions.size(),
+        deformflag,
+        nullptr,
+        nullptr,
+        mesh);
+    return positions;
+  }
+};
+
+static void expect_positions_near(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_V3_NEAR(a[i], b[i], 1e-5f);
+  }
+}
+
+TEST_F(ArmatureDeformTest, skinning_matches_generic_normalized)
+{
+  assign_weights(true);
+  const Array<float3> result = deform(ARM_DEF_VGROUP, false);
+  expect_positions_near(result, deform(ARM_DEF_VGROUP, true));
+  EXPECT_NE(result[1], mesh->vert_positions()[1]);
+  EXPECT_EQ(result[5], mesh->vert_positions()[5]);
+}
+
+TEST_F(ArmatureDeformTest, skinning_matches_generic_unnormalized)
+{
+  assign_weights(false);
+  expect_positions_near(deform(ARM_DEF_VGROUP, false), deform(ARM_DEF_VGROUP, true));
+}
+
+TEST_F(ArmatureDeformTest, preserve_volume_not_skinned)
+{
+  assign_weights(false);
+  const int deformflag = ARM_DEF_VGROUP | ARM_DEF_QUATERNION;
+  const Array<float3> result = deform(deformflag, false);
+  expect_positions_near(result, deform(deformflag, true));
+
+  /* Dual quaternion blending differs from linear blending where bones rotate differently. */
+  const Array<float3> result_linear = deform(ARM_DEF_VGROUP, false);
+  float max_difference = 0.0f;
+  for (const int i : result.index_range()) {
+    max_difference = std::max(max_difference, math::distance(result[i], result_linear[i]));
+  }
+  EXPECT_GT(max_difference, 1e-3f);
+}
+
+}  // namespace blender::bke::tests
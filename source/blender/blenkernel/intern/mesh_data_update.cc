@@ -19,6 +19,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_bitmap.h"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
@@ -981,11 +982,144 @@ static void mesh_build_extra_data(const Depsgraph &depsgraph,
   }
 }
 
+/**
+ * Take the evaluated mesh of the previous evaluation from the object if it is the result of deform
+ * modifiers only, so that its position dependent caches can be reused by
+ * #mesh_reuse_deformed_caches. The caller takes ownership of the returned mesh.
+ */
+static Mesh *take_previous_deformed_mesh(Object &ob)
+{
+  ObjectRuntime &runtime = *ob.runtime;
+  if (runtime.data_eval == nullptr || !runtime.is_data_eval_owned) {
+    return nullptr;
+  }
+  if (GS(runtime.data_eval->name) != ID_ME) {
+    return nullptr;
+  }
+  /* Sculpt mode manages the normals of the evaluated mesh itself. */
+  if (ob.sculpt) {
+    return nullptr;
+  }
+  Mesh *mesh = reinterpret_cast<Mesh *>(runtime.data_eval);
+  if (!mesh->runtime->deformed_only || mesh->runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+    return nullptr;
+  }
+  if (runtime.editmesh_eval_cage == mesh) {
+    return nullptr;
+  }
+  runtime.data_eval = nullptr;
+  return mesh;
+}
+
+/**
+ * Whether both meshes reference the same data for the attribute, or neither of them has it.
+ * Deformed copies of the same input mesh share the data of all attributes through implicit
+ * sharing, so different data means the attribute was changed in between the evaluations.
+ */
+static bool attribute_data_is_shared(const CustomData &data,
+                                     const CustomData &data_prev,
+                                     const eCustomDataType type,
+                                     const StringRef name)
+{
+  return CustomData_get_layer_named(&data, type, name) ==
+         CustomData_get_layer_named(&data_prev, type, name);
+}
+
+/** Whether the inputs of the corner normals besides positions and topology are unchanged. */
+static bool corner_normal_inputs_are_shared(const Mesh &mesh, const Mesh &mesh_prev)
+{
+  return attribute_data_is_shared(
+             mesh.edge_data, mesh_prev.edge_data, CD_PROP_BOOL, "sharp_edge") &&
+         attribute_data_is_shared(
+             mesh.face_data, mesh_prev.face_data, CD_PROP_BOOL, "sharp_face") &&
+         attribute_data_is_shared(
+             mesh.corner_data, mesh_prev.corner_data, CD_PROP_INT16_2D, "custom_normal");
+}
+
+/** Whether the hide attributes used by the `*_no_hidden` BVH trees are unchanged. */
+static bool hide_attributes_are_shared(const Mesh &mesh, const Mesh &mesh_prev)
+{
+  return attribute_data_is_shared(
+             mesh.vert_data, mesh_prev.vert_data, CD_PROP_BOOL, ".hide_vert") &&
+         attribute_data_is_shared(
+             mesh.edge_data, mesh_prev.edge_data, CD_PROP_BOOL, ".hide_edge") &&
+         attribute_data_is_shared(
+             mesh.face_data, mesh_prev.face_data, CD_PROP_BOOL, ".hide_poly");
+}
+
+void mesh_reuse_deformed_caches(Mesh &mesh_prev, Mesh &mesh)
+{
+  if (!mesh.runtime->deformed_only) {
+    return;
+  }
+  if (mesh.verts_num != mesh_prev.verts_num || mesh.edges_num != mesh_prev.edges_num ||
+      mesh.faces_num != mesh_prev.faces_num || mesh.corners_num != mesh_prev.corners_num)
+  {
+    return;
+  }
+  /* Both meshes are deformed copies of the same input mesh when they share the topology arrays.
+   * The previous mesh holds a reference to its arrays, so their memory can't have been reused. */
+  if (mesh.edges().data() != mesh_prev.edges().data() ||
+      mesh.face_offsets().data() != mesh_prev.face_offsets().data() ||
+      mesh.corner_verts().data() != mesh_prev.corner_verts().data())
+  {
+    return;
+  }
+
+  const Span<float3> positions_prev = mesh_prev.vert_positions();
+  const Span<float3> positions = mesh.vert_positions();
+  IndexMaskMemory memory;
+  const IndexMask changed_verts = IndexMask::from_predicate(
+      positions.index_range(), GrainSize(4096), memory, [&](const int vert) {
+        return positions[vert] != positions_prev[vert];
+      });
+
+  MeshRuntime &runtime = *mesh.runtime;
+  MeshRuntime &runtime_prev = *mesh_prev.runtime;
+  if (changed_verts.is_empty()) {
+    /* These caches only depend on positions and topology. */
+    runtime.bounds_cache = runtime_prev.bounds_cache;
+    runtime.vert_normals_cache = runtime_prev.vert_normals_cache;
+    runtime.face_normals_cache = runtime_prev.face_normals_cache;
+    runtime.corner_tris_cache = runtime_prev.corner_tris_cache;
+    runtime.shrinkwrap_boundary_cache = runtime_prev.shrinkwrap_boundary_cache;
+    runtime.bvh_cache_verts = runtime_prev.bvh_cache_verts;
+    runtime.bvh_cache_edges = runtime_prev.bvh_cache_edges;
+    runtime.bvh_cache_faces = runtime_prev.bvh_cache_faces;
+    runtime.bvh_cache_corner_tris = runtime_prev.bvh_cache_corner_tris;
+    runtime.bvh_cache_loose_verts = runtime_prev.bvh_cache_loose_verts;
+    runtime.bvh_cache_loose_edges = runtime_prev.bvh_cache_loose_edges;
+    /* Corner normals also depend on sharpness and custom normals, the remaining BVH trees on the
+     * hide attributes. Those may have been edited without changing the topology. */
+    if (corner_normal_inputs_are_shared(mesh, mesh_prev)) {
+      runtime.corner_normals_cache = runtime_prev.corner_normals_cache;
+    }
+    if (hide_attributes_are_shared(mesh, mesh_prev)) {
+      runtime.bvh_cache_corner_tris_no_hidden = runtime_prev.bvh_cache_corner_tris_no_hidden;
+      runtime.bvh_cache_loose_verts_no_hidden = runtime_prev.bvh_cache_loose_verts_no_hidden;
+      runtime.bvh_cache_loose_edges_no_hidden = runtime_prev.bvh_cache_loose_edges_no_hidden;
+    }
+    return;
+  }
+  if (!runtime_prev.face_normals_cache.is_cached()) {
+    return;
+  }
+
+  runtime.face_normals_cache = runtime_prev.face_normals_cache;
+  runtime.vert_normals_cache = runtime_prev.vert_normals_cache;
+  /* The previous mesh is about to be freed, release its references so the partial update below
+   * can modify the normals in place instead of copying them first. */
+  runtime_prev.face_normals_cache.tag_dirty();
+  runtime_prev.vert_normals_cache.tag_dirty();
+  mesh.tag_positions_changed(changed_verts);
+}
+
 static void mesh_build_data(Depsgraph &depsgraph,
                             const Scene &scene,
                             Object &ob,
                             const CustomData_MeshMasks &dataMask,
-                            const bool need_mapping)
+                            const bool need_mapping,
+                            Mesh *mesh_prev)
 {
 #if 0 /* XXX This is already taken care of in #mesh_calc_modifiers... */
   if (need_mapping) {
@@ -1018,6 +1152,12 @@ static void mesh_build_data(Depsgraph &depsgraph,
    * the final result might be freed prior to object). */
   Mesh *mesh = (Mesh *)ob.data;
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime->mesh_eval);
+  if (mesh_prev) {
+    if (is_mesh_eval_owned) {
+      mesh_reuse_deformed_caches(*mesh_prev, *mesh_eval);
+    }
+    BKE_id_free(nullptr, mesh_prev);
+  }
   BKE_object_eval_assign_data(&ob, &mesh_eval->id, is_mesh_eval_owned);
 
   /* Add the final mesh as a non-owning component to the geometry set. */
@@ -1152,6 +1292,7 @@ void mesh_data_update(Depsgraph &depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g #58150. */
   BLI_assert(ob.id.tag & ID_TAG_COPIED_ON_EVAL);
 
+  Mesh *mesh_prev = take_previous_deformed_mesh(ob);
   BKE_object_free_derived_caches(&ob);
   if (DEG_is_active(&depsgraph)) {
     BKE_sculpt_update_object_before_eval(&ob);
@@ -1168,10 +1309,13 @@ void mesh_data_update(Depsgraph &depsgraph,
   object_get_datamask(depsgraph, ob, cddata_masks, &need_mapping);
 
   if (mesh->runtime->edit_mesh) {
+    if (mesh_prev) {
+      BKE_id_free(nullptr, mesh_prev);
+    }
     editbmesh_build_data(depsgraph, scene, ob, cddata_masks);
   }
   else {
-    mesh_build_data(depsgraph, scene, ob, cddata_masks, need_mapping);
+    mesh_build_data(depsgraph, scene, ob, cddata_masks, need_mapping, mesh_prev);
   }
 }
 
@@ -1211,8 +1355,12 @@ Mesh *mesh_get_eval_deform(Depsgraph *depsgraph,
      * intended only to run during depsgraph-evaluation that overwrites the evaluated mesh
      * without freeing beforehand, see: !128228. */
     CustomData_MeshMasks_update(&cddata_masks, &ob->runtime->last_data_mask);
-    mesh_build_data(
-        *depsgraph, *scene, *ob, cddata_masks, need_mapping || ob->runtime->last_need_mapping);
+    mesh_build_data(*depsgraph,
+                    *scene,
+                    *ob,
+                    cddata_masks,
+                    need_mapping || ob->runtime->last_need_mapping,
+                    nullptr);
   }
 
   return ob->runtime->mesh_deform_eval;
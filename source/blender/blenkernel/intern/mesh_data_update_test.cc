@@ -0,0 +1,180 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdopbvh.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_attribute.hh"
+#include "BKE_bvhutils.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_runtime.hh"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::tests {
+
+class MeshDataUpdateTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/**
+ * Two quads folded along their shared edge, the first one marked as sharp so that the mesh has
+ * corner normals.
+ */
+static Mesh *create_folded_quads_mesh()
+{
+  Mesh *mesh = BKE_mesh_new_nomain(6, 7, 2, 8);
+  mesh->vert_positions_for_write().copy_from({float3(0, 0, 0),
+                                              float3(1, 0, 0),
+                                              float3(1, 1, 0),
+                                              float3(0, 1, 0),
+                                              float3(-1, 0, 1),
+                                              float3(-1, 1, 1)});
+  mesh->edges_for_write().copy_from(
+      {int2(0, 1), int2(1, 2), int2(2, 3), int2(3, 0), int2(4, 0), int2(3, 5), int2(5, 4)});
+  mesh->face_offsets_for_write().copy_from({0, 4, 8});
+  mesh->corner_verts_for_write().copy_from({0, 1, 2, 3, 4, 0, 3, 5});
+  mesh->corner_edges_for_write().copy_from({0, 1, 2, 3, 4, 3, 5, 6});
+
+  MutableAttributeAccessor attributes = mesh->attributes_for_write();
+  SpanAttributeWriter sharp_faces = attributes.lookup_or_add_for_write_span<bool>(
+      "sharp_face", AttrDomain::Face);
+  sharp_faces.span.copy_from({true, false});
+  sharp_faces.finish();
+  return mesh;
+}
+
+static Mesh *copy_as_deformed(const Mesh &mesh)
+{
+  Mesh *result = BKE_mesh_copy_for_eval(mesh);
+  result->runtime->deformed_only = true;
+  return result;
+}
+
+TEST_F(MeshDataUpdateTest, reuse_caches_unchanged)
+{
+  Mesh *input = create_folded_quads_mesh();
+  Mesh *mesh_prev = copy_as_deformed(*input);
+  const Span<float3> normals_prev = mesh_prev->corner_normals();
+
+  Mesh *mesh = copy_as_deformed(*input);
+  mesh_reuse_deformed_caches(*mesh_prev, *mesh);
+  EXPECT_EQ(mesh->corner_normals().data(), normals_prev.data());
+
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_prev);
+  BKE_id_free(nullptr, input);
+}
+
+TEST_F(MeshDataUpdateTest, reuse_caches_sharp_face_changed)
+{
+  Mesh *input = create_folded_quads_mesh();
+  Mesh *mesh_prev = copy_as_deformed(*input);
+  const Array<float3> normals_prev(mesh_prev->corner_normals());
+
+  /* Only edit the sharpness, positions and topology remain shared with the previous result. */
+  {
+    MutableAttributeAccessor attributes = input->attributes_for_write();
+    SpanAttributeWriter sharp_faces = attributes.lookup_for_write_span<bool>("sharp_face");
+    sharp_faces.span.fill(false);
+    sharp_faces.finish();
+  }
+
+  Mesh *mesh = copy_as_deformed(*input);
+  mesh_reuse_deformed_caches(*mesh_prev, *mesh);
+
+  Mesh *expected = BKE_mesh_copy_for_eval(*input);
+  const Span<float3> normals = mesh->corner_normals();
+  const Span<float3> normals_expected = expected->corner_normals();
+  ASSERT_EQ(normals.size(), normals_expected.size());
+  for (const int i : normals.index_range()) {
+    EXPECT_V3_NEAR(normals[i], normals_expected[i], 1e-6f);
+  }
+  /* The shared vertices are smooth now, so their normals must have changed. */
+  EXPECT_FALSE(math::is_equal(normals[0], normals_prev[0], 1e-3f));
+
+  BKE_id_free(nullptr, expected);
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_prev);
+  BKE_id_free(nullptr, input);
+}
+
+TEST_F(MeshDataUpdateTest, reuse_caches_positions_changed)
+{
+  Mesh *input = create_folded_quads_mesh();
+  Mesh *mesh_prev = copy_as_deformed(*input);
+  const Array<float3> normals_prev(mesh_prev->vert_normals());
+  mesh_prev->corner_normals();
+  mesh_prev->bounds_min_max();
+
+  Mesh *mesh = copy_as_deformed(*input);
+  mesh->vert_positions_for_write()[5] = float3(-1, 1, -1);
+  mesh->tag_positions_changed();
+  mesh_reuse_deformed_caches(*mesh_prev, *mesh);
+
+  /* Only the normals are updated from the previous result, the other caches must be rebuilt. */
+  EXPECT_FALSE(mesh->runtime->corner_normals_cache.is_cached());
+  EXPECT_FALSE(mesh->runtime->bounds_cache.is_cached());
+  EXPECT_EQ(mesh->bounds_min_max()->min, float3(-1, 0, -1));
+
+  Mesh *expected = copy_as_deformed(*mesh);
+  expected->tag_positions_changed();
+  const Span<float3> normals = mesh->vert_normals();
+  const Span<float3> normals_expected = expected->vert_normals();
+  ASSERT_EQ(normals.size(), normals_expected.size());
+  for (const int i : normals.index_range()) {
+    EXPECT_V3_NEAR(normals[i], normals_expected[i], 1e-6f);
+  }
+  EXPECT_FALSE(math::is_equal(normals[5], normals_prev[5], 1e-3f));
+  const Span<float3> corner_normals = mesh->corner_normals();
+  const Span<float3> corner_normals_expected = expected->corner_normals();
+  for (const int i : corner_normals.index_range()) {
+    EXPECT_V3_NEAR(corner_normals[i], corner_normals_expected[i], 1e-6f);
+  }
+
+  BKE_id_free(nullptr, expected);
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_prev);
+  BKE_id_free(nullptr, input);
+}
+
+TEST_F(MeshDataUpdateTest, reuse_caches_hide_changed)
+{
+  Mesh *input = create_folded_quads_mesh();
+  Mesh *mesh_prev = copy_as_deformed(*input);
+  mesh_prev->bvh_corner_tris();
+  mesh_prev->bvh_corner_tris_no_hidden();
+
+  {
+    MutableAttributeAccessor attributes = input->attributes_for_write();
+    SpanAttributeWriter hide_poly = attributes.lookup_or_add_for_write_span<bool>(
+        ".hide_poly", AttrDomain::Face);
+    hide_poly.span.copy_from({false, true});
+    hide_poly.finish();
+  }
+
+  Mesh *mesh = copy_as_deformed(*input);
+  mesh_reuse_deformed_caches(*mesh_prev, *mesh);
+  /* The positions are unchanged, but the BVH tree without hidden faces must be rebuilt. */
+  EXPECT_TRUE(mesh->runtime->bvh_cache_corner_tris.is_cached());
+  EXPECT_FALSE(mesh->runtime->bvh_cache_corner_tris_no_hidden.is_cached());
+  EXPECT_EQ(BLI_bvhtree_get_len(mesh->bvh_corner_tris_no_hidden().tree), 2);
+
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_prev);
+  BKE_id_free(nullptr, input);
+}
+
+}  // namespace blender::bke::tests
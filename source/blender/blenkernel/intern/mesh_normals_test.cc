@@ -0,0 +1,214 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::tests {
+
+class MeshNormalsTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/** A grid of quads with a wavy height, so that all normals are different. */
+static Mesh *create_wavy_grid_mesh(const int size)
+{
+  const int verts_num = size * size;
+  const int faces_num = (size - 1) * (size - 1);
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, faces_num, faces_num * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      positions[y * size + x] = float3(x, y, math::sin(x * 0.7f) * math::cos(y * 0.4f));
+    }
+  }
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(size - 1)) {
+    for (const int x : IndexRange(size - 1)) {
+      const int face = y * (size - 1) + x;
+      face_offsets[face] = face * 4;
+      corner_verts[face * 4 + 0] = y * size + x;
+      corner_verts[face * 4 + 1] = y * size + x + 1;
+      corner_verts[face * 4 + 2] = (y + 1) * size + x + 1;
+      corner_verts[face * 4 + 3] = (y + 1) * size + x;
+    }
+  }
+  mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+/**
+ * A fan of triangles around a vertex used by more than four faces, so that the vectorized corner
+ * angle code is used, with degenerate faces mixed in: a zero area triangle with two vertices at
+ * the same position, a triangle with collinear vertices, and a loose vertex.
+ */
+static Mesh *create_degenerate_mesh()
+{
+  const int fan_num = 7;
+  Mesh *mesh = BKE_mesh_new_nomain(18, 0, 11, 35);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  positions[0] = float3(0.0f, 0.0f, 0.2f);
+  for (const int i : IndexRange(fan_num)) {
+    const float angle = float(i) * 2.0f * float(math::numbers::pi) / fan_num;
+    positions[1 + i] = float3(math::cos(angle), math::sin(angle), 0.1f * float(i % 3));
+  }
+  positions[8] = positions[1];
+  positions[9] = float3(2, 0, 0);
+  positions[10] = float3(3, 0, 0);
+  positions[11] = float3(4, 0, 0);
+  for (const int i : IndexRange(5)) {
+    const float angle = float(i) * 2.0f * float(math::numbers::pi) / 5;
+    positions[12 + i] = float3(math::cos(angle), math::sin(angle), 0.0f) + float3(5, 0, 0);
+  }
+  positions[17] = float3(1, 2, 3);
+
+  Vector<int> corner_verts;
+  for (const int i : IndexRange(fan_num)) {
+    corner_verts.extend({0, 1 + i, 1 + (i + 1) % fan_num});
+  }
+  corner_verts.extend({1, 8, 2});
+  corner_verts.extend({0, 1, 8});
+  corner_verts.extend({9, 10, 11});
+  corner_verts.extend({12, 13, 14, 15, 16});
+  mesh->corner_verts_for_write().copy_from(corner_verts);
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  for (const int i : IndexRange(10)) {
+    face_offsets[i] = i * 3;
+  }
+  face_offsets[10] = 30;
+  mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+/** The scalar calculation the vectorized normal code is meant to match exactly. */
+static Array<float3> face_normals_reference(const Mesh &mesh)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  Array<float3> normals(faces.size());
+  for (const int face : faces.index_range()) {
+    const Span<int> face_verts = corner_verts.slice(faces[face]);
+    float3 normal(0);
+    const float *v_prev = positions[face_verts.last()];
+    for (const int vert : face_verts) {
+      const float *v_curr = positions[vert];
+      add_newell_cross_v3_v3v3(normal, v_prev, v_curr);
+      v_prev = v_curr;
+    }
+    if (normalize_v3(normal) == 0.0f) {
+      normal[2] = 1.0f;
+    }
+    normals[face] = normal;
+  }
+  return normals;
+}
+
+static Array<float3> vert_normals_reference(const Mesh &mesh, const Span<float3> face_normals)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const GroupedSpan<int> vert_to_face_map = mesh.vert_to_face_map();
+  Array<float3> normals(positions.size());
+  for (const int vert : positions.index_range()) {
+    if (vert_to_face_map[vert].is_empty()) {
+      normals[vert] = math::normalize(positions[vert]);
+      continue;
+    }
+    float3 normal(0);
+    for (const int face : vert_to_face_map[vert]) {
+      const int2 adjacent_verts = mesh::face_find_adjacent_verts(faces[face], corner_verts, vert);
+      const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+      const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+      normal += face_normals[face] * math::safe_acos_approx(math::dot(dir_prev, dir_next));
+    }
+    normals[vert] = math::normalize(normal);
+  }
+  return normals;
+}
+
+static void expect_normals_eq(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_EQ(a[i], b[i]) << "Index " << i;
+  }
+}
+
+TEST_F(MeshNormalsTest, degenerate_faces_match_scalar)
+{
+  Mesh *mesh = create_degenerate_mesh();
+  const Array<float3> face_normals = face_normals_reference(*mesh);
+  expect_normals_eq(mesh->face_normals(), face_normals);
+  expect_normals_eq(mesh->vert_normals(), vert_normals_reference(*mesh, face_normals));
+  /* The zero area and collinear faces use the fallback normal. */
+  EXPECT_EQ(mesh->face_normals()[7], float3(0, 0, 1));
+  EXPECT_EQ(mesh->face_normals()[9], float3(0, 0, 1));
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST_F(MeshNormalsTest, partial_update_matches_full)
+{
+  Mesh *mesh = create_wavy_grid_mesh(12);
+  mesh->face_normals();
+  mesh->vert_normals();
+
+  const Array<int> moved_verts = {0, 5, 40, 77, 143};
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int vert : moved_verts) {
+    positions[vert] += float3(0.1f, -0.3f, 0.5f);
+  }
+  IndexMaskMemory memory;
+  mesh->tag_positions_changed(IndexMask::from_indices(moved_verts.as_span(), memory));
+  /* The normals are updated in place rather than being tagged for a full recalculation. */
+  EXPECT_TRUE(mesh->runtime->face_normals_cache.is_cached());
+  EXPECT_TRUE(mesh->runtime->vert_normals_cache.is_cached());
+
+  const Array<float3> face_normals = face_normals_reference(*mesh);
+  expect_normals_eq(mesh->face_normals(), face_normals);
+  expect_normals_eq(mesh->vert_normals(), vert_normals_reference(*mesh, face_normals));
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST_F(MeshNormalsTest, partial_update_many_verts)
+{
+  Mesh *mesh = create_wavy_grid_mesh(6);
+  mesh->vert_normals();
+
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (float3 &position : positions.take_front(20)) {
+    position.z += 1.0f;
+  }
+  mesh->tag_positions_changed(IndexRange(20));
+  /* Too many vertices moved for a partial update to be worth it. */
+  EXPECT_FALSE(mesh->runtime->face_normals_cache.is_cached());
+
+  const Array<float3> face_normals = face_normals_reference(*mesh);
+  expect_normals_eq(mesh->face_normals(), face_normals);
+  expect_normals_eq(mesh->vert_normals(), vert_normals_reference(*mesh, face_normals));
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
@@ -7,6 +7,8 @@
  */
 
 #include "BLI_array_utils.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 
 #include "BKE_bake_data_block_id.hh"
@@ -392,6 +394,60 @@ void Mesh::tag_positions_changed()
   this->tag_positions_changed_no_normals();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  /* A partial update is only possible when there are normals to update, and only worth it when it
+   * is much less work than recalculating everything. */
+  if (changed_verts.size() > this->verts_num / 4 ||
+      !this->runtime->face_normals_cache.is_cached())
+  {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face_map = this->vert_to_face_map();
+
+  /* Moving a vertex changes the normals of its faces, which in turn change the normals of all the
+   * vertices of those faces. */
+  BitVector<> faces_to_update(faces.size(), false);
+  BitVector<> verts_to_update(this->verts_num, false);
+  changed_verts.foreach_index([&](const int vert) {
+    verts_to_update[vert].set();
+    for (const int face : vert_to_face_map[vert]) {
+      faces_to_update[face].set();
+    }
+  });
+  IndexMaskMemory memory;
+  const IndexMask face_mask = IndexMask::from_bits(faces_to_update, memory);
+  face_mask.foreach_index([&](const int face) {
+    for (const int vert : corner_verts.slice(faces[face])) {
+      verts_to_update[vert].set();
+    }
+  });
+  const IndexMask vert_mask = IndexMask::from_bits(verts_to_update, memory);
+
+  this->runtime->face_normals_cache.update([&](Vector<float3> &r_data) {
+    bke::mesh::normals_calc_faces(positions, faces, corner_verts, face_mask, r_data);
+  });
+  if (this->runtime->vert_normals_cache.is_cached()) {
+    const Span<float3> face_normals = this->runtime->face_normals_cache.data();
+    this->runtime->vert_normals_cache.update([&](Vector<float3> &r_data) {
+      bke::mesh::normals_calc_verts(
+          positions, faces, corner_verts, vert_to_face_map, face_normals, vert_mask, r_data);
+    });
+  }
+  else {
+    this->runtime->vert_normals_cache.tag_dirty();
+  }
+  this->runtime->corner_normals_cache.tag_dirty();
+  this->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  this->tag_positions_changed_no_normals();
+}
+
 void Mesh::tag_positions_changed_no_normals()
 {
   free_bvh_caches(*this->runtime);
@@ -87,6 +87,11 @@ float linearrgb_to_srgb(float c);
 
 void srgb_to_linearrgb_v3_v3(float linear[3], const float srgb[3]);
 void linearrgb_to_srgb_v3_v3(float srgb[3], const float linear[3]);
+/**
+ * Convert an array of linear values to sRGB in place, four values at a time. The result is the
+ * same as that of #linearrgb_to_srgb_v3_v3 for each value.
+ */
+void linearrgb_to_srgb_array(float *values, int values_num);
 
 MINLINE void srgb_to_linearrgb_v4(float linear[4], const float srgb[4]);
 MINLINE void linearrgb_to_srgb_v4(float srgb[4], const float linear[4]);
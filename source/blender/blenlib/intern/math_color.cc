@@ -577,6 +577,21 @@ void linearrgb_to_srgb_v3_v3(float srgb[3], const float linear[3])
   srgb[2] = r[2];
 }
 
+void linearrgb_to_srgb_array(float *values, const int values_num)
+{
+  int i = 0;
+  for (; i + 4 <= values_num; i += 4) {
+    _mm_storeu_ps(values + i, linearrgb_to_srgb_v4_simd(_mm_loadu_ps(values + i)));
+  }
+  if (i < values_num) {
+    float r[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    memcpy(r, values + i, sizeof(float) * size_t(values_num - i));
+    __m128 *rv = (__m128 *)&r;
+    *rv = linearrgb_to_srgb_v4_simd(*rv);
+    memcpy(values + i, r, sizeof(float) * size_t(values_num - i));
+  }
+}
+
 #else /* BLI_HAVE_SSE2 */
 
 /* Non-SIMD code path, with the same pow approximations as SIMD one. */
@@ -674,6 +689,13 @@ void linearrgb_to_srgb_v3_v3(float srgb[3], const float linear[3])
   srgb[2] = linearrgb_to_srgb_approx(linear[2]);
 }
 
+void linearrgb_to_srgb_array(float *values, const int values_num)
+{
+  for (int i = 0; i < values_num; i++) {
+    values[i] = linearrgb_to_srgb_approx(values[i]);
+  }
+}
+
 #endif /* BLI_HAVE_SSE2 */
 
 /* ************************************* other ************************************************* */
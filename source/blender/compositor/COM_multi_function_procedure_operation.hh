@@ -64,10 +64,19 @@ class MultiFunctionProcedureOperation : public PixelOperation {
                                   const Schedule &schedule);
 
   /* Calls the multi-function procedure executor on the domain of the operator passing in the
-   * inputs and outputs as parameters. */
+   * inputs and outputs as parameters. The domain is evaluated in parallel in small tiles, such that
+   * the intermediate values of the fused nodes stay in the CPU cache. */
   void execute() override;
 
  private:
+  /* Calls the multi-function procedure executor on the given range of pixels of the domain,
+   * assuming the outputs were already allocated. */
+  void execute_tile(IndexRange tile);
+
+  /* Calls the multi-function procedure executor once for an operation whose inputs are all single
+   * values, producing single value outputs. */
+  void execute_single_value();
+
   /* Builds the procedure by going over the nodes in the compile unit, calling their
    * multi-functions and creating any necessary inputs or outputs to the operation/procedure. */
   void build_procedure();
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
+#include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 
 #include "DNA_node_types.h"
@@ -32,14 +36,17 @@ class NodeOperation : public Operation {
  private:
   /* The node that this operation represents. */
   DNode node_;
+  /* The hash of the node parameters and inputs computed in load_cached_results, if the results of
+   * the node can be cached. Used to store the computed results in store_cached_results. */
+  std::optional<uint64_t> inputs_hash_;
 
  public:
   /* Populate the output results based on the node outputs and populate the input descriptors based
    * on the node inputs. */
   NodeOperation(Context &context, DNode node);
 
-  /* Calls the evaluate method of the operation, but also measures the execution time and stores it
-   * in the context's profile data. */
+  /* Calls the evaluate method of the operation, but also measures the execution time and memory
+   * usage and stores them in the context's profile data. */
   void evaluate() override;
 
   /* Compute and set the initial reference counts of all the results of the operation. The
@@ -52,6 +59,14 @@ class NodeOperation : public Operation {
   /* Compute a node preview using the result returned from the get_preview_result method. */
   void compute_preview() override;
 
+  /* Retrieve the needed results from the cached node results of the context if the node can be
+   * cached and its parameters and inputs did not change since the results were cached. */
+  bool load_cached_results() override;
+
+  /* Store the computed results in the cached node results of the context if the node can be
+   * cached, see load_cached_results. */
+  void store_cached_results() override;
+
   /* Returns a reference to the derived node that this operation represents. */
   const DNode &node() const;
 
@@ -68,6 +83,20 @@ class NodeOperation : public Operation {
    * guaranteed not to be returned, since the node will always either have a linked output or an
    * allocated input. */
   Result *get_preview_result();
+
+  /* Returns true if the results of the node can be cached across evaluations. This is not the
+   * case for nodes that reference data-blocks, whose content can change without the node tree
+   * changing, for source nodes without linked inputs, which are cheap to evaluate, and for
+   * evaluations that are part of a render, which are not repeated. */
+  bool is_cacheable() const;
+
+  /* Compute a hash of the node parameters, its inputs, and the relevant context settings. */
+  uint64_t compute_inputs_hash();
 };
 
+/* Compute a hash of the parameters of the given node, including its DNA storage, the content of the
+ * given input results, and the context settings that affect the results of nodes. Results cached
+ * for one hash are reused only if the hash is unchanged, see NodeOperation::load_cached_results. */
+uint64_t compute_node_inputs_hash(Context &context, const bNode &node, Span<const Result *> inputs);
+
 }  // namespace blender::compositor
@@ -91,7 +91,8 @@ class Operation {
   /* Evaluate the operation by:
    * 1. Evaluating the input processors.
    * 2. Resetting the results of the operation.
-   * 3. Calling the execute method of the operation.
+   * 3. Calling the execute method of the operation, unless its results could be loaded from the
+   *    cache, then storing the computed results in the cache.
    * 4. Releasing the results mapped to the inputs. */
   virtual void evaluate();
 
@@ -138,6 +139,16 @@ class Operation {
    * implementation and should be implemented by operations which can have previews. */
   virtual void compute_preview();
 
+  /* Set up the needed results of the operation from results cached in a previous evaluation and
+   * return true, in which case the operation is not executed. Returns false if any of the needed
+   * results is not cached. This method defaults to an implementation that returns false and
+   * should be implemented by operations whose results can be cached. */
+  virtual bool load_cached_results();
+
+  /* Store the results computed by the execute method in the cache for future evaluations. This
+   * method defaults to an empty implementation, see load_cached_results. */
+  virtual void store_cached_results();
+
   /* Get a reference to the result connected to the input identified by the given identifier. */
   Result &get_input(StringRef identifier) const;
 
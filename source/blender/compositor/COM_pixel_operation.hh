@@ -103,6 +103,10 @@ class PixelOperation : public Operation {
    * number returned by this method. */
   static int maximum_number_of_outputs(Context &context);
 
+  /* Calls the evaluate method of the operation, but also records the evaluation in the timeline
+   * of the context's profile data if one exists. */
+  void evaluate() override;
+
   /* Compute a node preview for all nodes in the pixel operations if the node requires a preview.
    *
    * Previews are computed from results that are populated for outputs that are used to compute
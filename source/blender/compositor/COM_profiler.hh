@@ -4,8 +4,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <mutex>
+#include <string>
+
 #include "BLI_map.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
 
@@ -13,11 +19,33 @@ namespace blender::compositor {
 
 class Context;
 
+/* Memory statistics of the results allocated during the evaluation of an operation. */
+struct OperationMemoryStatistics {
+  /* The total size of the results allocated during the evaluation. */
+  int64_t allocated_bytes = 0;
+  /* The peak size of all live results during the evaluation, including the results allocated by
+   * previous operations that were not yet freed. */
+  int64_t peak_live_bytes = 0;
+};
+
+/* An entry in the evaluation timeline of the profiler. */
+struct ProfilerTimelineEvent {
+  std::string name;
+  timeit::TimePoint start;
+  timeit::TimePoint end;
+  /* An index identifying the thread that evaluated the operation. */
+  int thread;
+  OperationMemoryStatistics memory;
+  /* The size of all live results at the end of the evaluation. */
+  int64_t live_bytes;
+};
+
 /* -------------------------------------------------------------------------------------------------
  * Profiler
  *
  * A class that profiles the evaluation of the compositor and tracks information like the
- * evaluation time of every node. */
+ * evaluation time and memory usage of every node, as well as a timeline of the evaluation of all
+ * operations which can be written to a file in the Trace Event Format. */
 class Profiler {
  private:
   /* Stores the evaluation time of each node instance keyed by its instance key. Note that
@@ -25,6 +53,22 @@ class Profiler {
    * together with other pixel-wise operations in a single operation, so we can't measure the
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
+  /* Stores the memory statistics of each node instance keyed by its instance key. Like evaluation
+   * times, pixel-wise nodes are not included. */
+  Map<bNodeInstanceKey, OperationMemoryStatistics> nodes_memory_statistics_;
+  /* The evaluated operations in the order of their evaluation. */
+  Vector<ProfilerTimelineEvent> timeline_;
+  /* Maps the hash of thread identifiers to the indices used in the timeline. */
+  Map<size_t, int> thread_indices_;
+  /* The time at which the profiler was created, timeline events are relative to it. */
+  timeit::TimePoint creation_time_ = timeit::Clock::now();
+
+  /* The total size of the currently allocated results, as well as the memory statistics of the
+   * operation that is currently being evaluated. Results might be allocated from multiple
+   * threads, so they are protected by a mutex. */
+  std::mutex memory_mutex_;
+  int64_t live_bytes_ = 0;
+  OperationMemoryStatistics current_memory_statistics_;
 
  public:
   /* Returns a reference to the nodes evaluation times. */
@@ -33,9 +77,40 @@ class Profiler {
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
+  /* Returns a reference to the nodes memory statistics. */
+  Map<bNodeInstanceKey, OperationMemoryStatistics> &get_nodes_memory_statistics();
+
+  /* Add the given memory statistics to those of the node identified by the given instance key. */
+  void add_node_memory_statistics(bNodeInstanceKey node_instance_key,
+                                  const OperationMemoryStatistics &statistics);
+
+  /* Track the allocation and freeing of the data of results of the given size. */
+  void add_result_allocation(int64_t size_in_bytes);
+  void add_result_free(int64_t size_in_bytes);
+
+  /* Start tracking the memory statistics of the evaluation of an operation. Should be followed by
+   * a call to end_operation_evaluation once the operation was evaluated. */
+  void begin_operation_evaluation();
+
+  /* Stop tracking the memory statistics of the evaluation of an operation, adding an entry with
+   * the given name and evaluation interval to the timeline, and return the memory statistics of
+   * the evaluation. */
+  OperationMemoryStatistics end_operation_evaluation(StringRef name,
+                                                     timeit::TimePoint start,
+                                                     timeit::TimePoint end);
+
+  /* Returns a reference to the evaluation timeline. */
+  Span<ProfilerTimelineEvent> get_timeline() const;
+
   /* Finalize profiling by computing node group times. This should be called after evaluation. */
   void finalize(const bNodeTree &node_tree);
 
+  /* Write the evaluation timeline to the file at the given path in the Trace Event Format, which
+   * can be viewed in tools like Perfetto or `chrome://tracing`. Evaluations are written as
+   * duration events with their memory statistics, and the live memory of results is written as
+   * a counter. Returns false if the file could not be written. */
+  bool write_trace(StringRefNull filepath) const;
+
  private:
   /* Computes the evaluation time of every group node inside the given tree recursively by
    * accumulating the evaluation time of its nodes, setting the computed time to the group nodes.
@@ -366,6 +366,15 @@ class Result {
   /* Returns true if the result is allocated. */
   bool is_allocated() const;
 
+  /* Returns the size of the data of the result in bytes, or zero if it is not allocated. */
+  int64_t size_in_bytes() const;
+
+  /* Returns true if the result wraps external data, see the is_external_ member. */
+  bool is_external() const;
+
+  /* Returns true if the result is a proxy of a master result, see the master_ member. */
+  bool is_proxy() const;
+
   /* Returns the reference count of the result. If this result have a master result, then the
    * reference count of the master result is returned instead. */
   int reference_count() const;
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include "BLI_array.hh"
 #include "BLI_index_range.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_task.hh"
 
 #include "NOD_derived_node_tree.hh"
@@ -88,4 +92,38 @@ template<typename Function> inline void parallel_for(const int2 range, const Fun
   });
 }
 
+/* Executes the given function in parallel over the rows of the transpose of the given output,
+ * writing the computed rows as columns of the output. The given function gets the index of the row
+ * and a span of the size of the height of the output where the row should be written. Rows are
+ * computed in blocks before being written, such that the transposed writes to the output are
+ * contiguous in memory. This is useful for separable filters, which can then be implemented as
+ * row filters that are applied twice, see symmetric_separable_blur for an example. */
+template<typename T, typename Function>
+inline void parallel_for_transposed_rows(Result &output, const Function &function)
+{
+  const int64_t rows_count = output.domain().size.x;
+  const int64_t row_size = output.domain().size.y;
+  MutableSpan<T> output_data = output.cpu_data().typed<T>();
+
+  constexpr int64_t rows_block_size = 16;
+  threading::parallel_for(IndexRange(rows_count), rows_block_size, [&](const IndexRange sub_range) {
+    Array<T> block(rows_block_size * row_size, NoInitialization());
+    for (int64_t block_start = sub_range.first(); block_start < sub_range.one_after_last();
+         block_start += rows_block_size)
+    {
+      const int64_t block_rows = std::min(rows_block_size, sub_range.one_after_last() - block_start);
+      for (const int64_t i : IndexRange(block_rows)) {
+        function(block_start + i, block.as_mutable_span().slice(i * row_size, row_size));
+      }
+
+      for (const int64_t x : IndexRange(row_size)) {
+        MutableSpan<T> output_column = output_data.slice(x * rows_count + block_start, block_rows);
+        for (const int64_t i : IndexRange(block_rows)) {
+          output_column[i] = block[i * row_size + x];
+        }
+      }
+    }
+  });
+}
+
 }  // namespace blender::compositor
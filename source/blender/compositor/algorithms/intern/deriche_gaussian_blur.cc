@@ -2,9 +2,12 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cstdint>
+
 #include "BLI_assert.h"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 
@@ -19,7 +22,18 @@ namespace blender::compositor {
 
 #define FILTER_ORDER 4
 
-/* See sum_causal_and_non_causal_results. */
+/* Sum the causal and non causal outputs of the filter and write the sum to the output. This is
+ * because the Deriche filter is a parallel interconnection filter, meaning its output is the sum
+ * of its causal and non causal filters. The output is expected not to be allocated as it will be
+ * allocated internally.
+ *
+ * The output is allocated and written transposed, that is, with a height equivalent to the width
+ * of the input and vice versa. This is done as a performance optimization. The blur pass will
+ * blur the image horizontally and write it to the intermediate output transposed. Then the
+ * vertical pass will execute the same horizontal blur shader, but since its input is transposed,
+ * it will effectively do a vertical blur and write to the output transposed, effectively undoing
+ * the transposition in the horizontal pass. This is done to improve spatial cache locality in the
+ * shader and to avoid having two separate shaders for each blur pass. */
 static void sum_causal_and_non_causal_results_gpu(Context &context,
                                                   const Result &causal_input,
                                                   const Result &non_causal_input,
@@ -44,57 +58,11 @@ static void sum_causal_and_non_causal_results_gpu(Context &context,
   output.unbind_as_image();
 }
 
-/* See sum_causal_and_non_causal_results. */
-static void sum_causal_and_non_causal_results_cpu(const Result &causal_input,
-                                                  const Result &non_causal_input,
-                                                  Result &output)
-{
-  const Domain domain = causal_input.domain();
-  const int2 transposed_domain = int2(domain.size.y, domain.size.x);
-  output.allocate_texture(transposed_domain);
-
-  parallel_for(domain.size, [&](const int2 texel) {
-    /* The Deriche filter is a parallel interconnection filter, meaning its output is the sum of
-     * its causal and non causal filters. */
-    float4 filter_output = causal_input.load_pixel<float4>(texel) +
-                           non_causal_input.load_pixel<float4>(texel);
-
-    /* Write the color using the transposed texel. See the sum_causal_and_non_causal_results method
-     * in the deriche_gaussian_blur.cc file for more information on the rational behind this. */
-    output.store_pixel(int2(texel.y, texel.x), filter_output);
-  });
-}
-
-/* Sum the causal and non causal outputs of the filter and write the sum to the output. This is
- * because the Deriche filter is a parallel interconnection filter, meaning its output is the sum
- * of its causal and non causal filters. The output is expected not to be allocated as it will be
- * allocated internally.
- *
- * The output is allocated and written transposed, that is, with a height equivalent to the width
- * of the input and vice versa. This is done as a performance optimization. The blur pass will
- * blur the image horizontally and write it to the intermediate output transposed. Then the
- * vertical pass will execute the same horizontal blur shader, but since its input is transposed,
- * it will effectively do a vertical blur and write to the output transposed, effectively undoing
- * the transposition in the horizontal pass. This is done to improve spatial cache locality in the
- * shader and to avoid having two separate shaders for each blur pass. */
-static void sum_causal_and_non_causal_results(Context &context,
-                                              const Result &causal_input,
-                                              const Result &non_causal_input,
-                                              Result &output)
-{
-  if (context.use_gpu()) {
-    sum_causal_and_non_causal_results_gpu(context, causal_input, non_causal_input, output);
-  }
-  else {
-    sum_causal_and_non_causal_results_cpu(causal_input, non_causal_input, output);
-  }
-}
-
-static void blur_pass_gpu(Context &context,
-                          const Result &input,
-                          Result &causal_result,
-                          Result &non_causal_result,
-                          const float sigma)
+static void compute_causal_and_non_causal_results_gpu(Context &context,
+                                                      const Result &input,
+                                                      Result &causal_result,
+                                                      Result &non_causal_result,
+                                                      const float sigma)
 {
   GPUShader *shader = context.get_shader("compositor_deriche_gaussian_blur");
   GPU_shader_bind(shader);
@@ -134,11 +102,90 @@ static void blur_pass_gpu(Context &context,
   non_causal_result.unbind_as_image();
 }
 
-static void blur_pass_cpu(Context &context,
-                          const Result &input,
-                          Result &causal_output,
-                          Result &non_causal_output,
-                          const float sigma)
+static void blur_pass_gpu(Context &context, const Result &input, Result &output, const float sigma)
+{
+  Result causal_result = context.create_result(ResultType::Color);
+  Result non_causal_result = context.create_result(ResultType::Color);
+
+  compute_causal_and_non_causal_results_gpu(
+      context, input, causal_result, non_causal_result, sigma);
+  sum_causal_and_non_causal_results_gpu(context, causal_result, non_causal_result, output);
+
+  causal_result.release();
+  non_causal_result.release();
+}
+
+/* Apply the causal or non causal filter on the given input row, writing the result to the given
+ * output row if IsCausal is true, and adding to it otherwise. See the blur_pass_cpu function for
+ * more information. */
+template<bool IsCausal>
+static void apply_filter_cpu(const Span<float4> input_row,
+                             MutableSpan<float4> output_row,
+                             const float4 &feedforward_coefficients,
+                             const float4 &feedback_coefficients,
+                             const float boundary_coefficient)
+{
+  const int width = input_row.size();
+
+  /* Create an array that holds the last FILTER_ORDER inputs along with the current input. The
+   * current input is at index 0 and the oldest input is at index FILTER_ORDER. We assume Neumann
+   * boundary condition, so we initialize all inputs by the boundary pixel. */
+  const float4 input_boundary = IsCausal ? input_row.first() : input_row.last();
+  float4 inputs[FILTER_ORDER + 1] = {
+      input_boundary, input_boundary, input_boundary, input_boundary, input_boundary};
+
+  /* Create an array that holds the last FILTER_ORDER outputs along with the current output. The
+   * current output is at index 0 and the oldest output is at index FILTER_ORDER. We assume
+   * Neumann boundary condition, so we initialize all outputs by the boundary pixel multiplied by
+   * the boundary coefficient. See the DericheGaussianCoefficients class for more information on
+   * the boundary handing. */
+  const float4 output_boundary = input_boundary * boundary_coefficient;
+  float4 outputs[FILTER_ORDER + 1] = {
+      output_boundary, output_boundary, output_boundary, output_boundary, output_boundary};
+
+  for (int i = 0; i < width; i++) {
+    /* Run forward across rows for the causal filter and backward for the non causal filter. */
+    const int x = IsCausal ? i : width - 1 - i;
+    inputs[0] = input_row[x];
+
+    /* Compute Equation (28) for the causal filter or Equation (29) for the non causal filter.
+     * The only difference is that the non causal filter ignores the current value and starts
+     * from the previous input, as can be seen in the subscript of the first input term in both
+     * equations. So add one while indexing the non causal inputs. */
+    outputs[0] = float4(0.0f);
+    const int first_input_index = IsCausal ? 0 : 1;
+    for (int j = 0; j < FILTER_ORDER; j++) {
+      outputs[0] += feedforward_coefficients[j] * inputs[first_input_index + j];
+      outputs[0] -= feedback_coefficients[j] * outputs[j + 1];
+    }
+
+    /* The Deriche filter is a parallel interconnection filter, meaning its output is the sum of
+     * its causal and non causal filters. The causal filter runs first, so it initializes the
+     * output and the non causal filter adds to it. */
+    if constexpr (IsCausal) {
+      output_row[x] = outputs[0];
+    }
+    else {
+      output_row[x] += outputs[0];
+    }
+
+    /* Shift the inputs temporally by one. The oldest input is discarded, while the current input
+     * will retain its value but will be overwritten with the new current value in the next
+     * iteration. */
+    for (int j = FILTER_ORDER; j >= 1; j--) {
+      inputs[j] = inputs[j - 1];
+    }
+
+    /* Shift the outputs temporally by one. The oldest output is discarded, while the current
+     * output will retain its value but will be overwritten with the new current value in the
+     * next iteration. */
+    for (int j = FILTER_ORDER; j >= 1; j--) {
+      outputs[j] = outputs[j - 1];
+    }
+  }
+}
+
+static void blur_pass_cpu(Context &context, const Result &input, Result &output, const float sigma)
 {
   const DericheGaussianCoefficients &coefficients =
       context.cache_manager().deriche_gaussian_coefficients.get(context, sigma);
@@ -152,109 +199,49 @@ static void blur_pass_cpu(Context &context,
   const float non_causal_boundary_coefficient = float(
       coefficients.non_causal_boundary_coefficient());
 
+  /* The output is allocated and written transposed, see the sum_causal_and_non_causal_results_gpu
+   * function for more information on the reasoning behind this. */
   const Domain domain = input.domain();
-  causal_output.allocate_texture(domain);
-  non_causal_output.allocate_texture(domain);
+  const int2 transposed_domain = int2(domain.size.y, domain.size.x);
+  output.allocate_texture(transposed_domain);
+
+  const int width = domain.size.x;
+  const Span<float4> input_data = input.cpu_data().typed<float4>();
 
-  /* The first dispatch dimension is two dispatches, one for the causal filter and one for the non
-   * causal one. */
-  const int2 parallel_for_size = int2(2, domain.size.y);
   /* Blur the input horizontally by applying a fourth order IIR filter approximating a Gaussian
    * filter using Deriche's design method. This is based on the following paper:
    *
    *   Deriche, Rachid. Recursively implementating the Gaussian and its derivatives. Diss. INRIA,
    *   1993.
    *
-   * We run two filters per row in parallel, one for the causal filter and one for the non causal
-   * filter, storing the result of each separately. See the DericheGaussianCoefficients class and
-   * the implementation for more information. */
-  parallel_for(parallel_for_size, [&](const int2 invocation) {
-    /* The code runs parallel across rows but serially across columns. */
-    int y = invocation.y;
-    int width = input.domain().size.x;
-
-    /* The second dispatch dimension is two dispatches, one for the causal filter and one for the
-     * non causal one. */
-    bool is_causal = invocation.x == 0;
-    float4 feedforward_coefficients = is_causal ? causal_feedforward_coefficients :
-                                                  non_causal_feedforward_coefficients;
-    float boundary_coefficient = is_causal ? causal_boundary_coefficient :
-                                             non_causal_boundary_coefficient;
-
-    /* Create an array that holds the last FILTER_ORDER inputs along with the current input. The
-     * current input is at index 0 and the oldest input is at index FILTER_ORDER. We assume Neumann
-     * boundary condition, so we initialize all inputs by the boundary pixel. */
-    int2 boundary_texel = is_causal ? int2(0, y) : int2(width - 1, y);
-    float4 input_boundary = input.load_pixel<float4>(boundary_texel);
-    float4 inputs[FILTER_ORDER + 1] = {
-        input_boundary, input_boundary, input_boundary, input_boundary, input_boundary};
-
-    /* Create an array that holds the last FILTER_ORDER outputs along with the current output. The
-     * current output is at index 0 and the oldest output is at index FILTER_ORDER. We assume
-     * Neumann boundary condition, so we initialize all outputs by the boundary pixel multiplied by
-     * the boundary coefficient. See the DericheGaussianCoefficients class for more information on
-     * the boundary handing. */
-    float4 output_boundary = input_boundary * boundary_coefficient;
-    float4 outputs[FILTER_ORDER + 1] = {
-        output_boundary, output_boundary, output_boundary, output_boundary, output_boundary};
-
-    for (int x = 0; x < width; x++) {
-      /* Run forward across rows for the causal filter and backward for the non causal filter. */
-      int2 texel = is_causal ? int2(x, y) : int2(width - 1 - x, y);
-      inputs[0] = input.load_pixel<float4>(texel);
-
-      /* Compute Equation (28) for the causal filter or Equation (29) for the non causal filter.
-       * The only difference is that the non causal filter ignores the current value and starts
-       * from the previous input, as can be seen in the subscript of the first input term in both
-       * equations. So add one while indexing the non causal inputs. */
-      outputs[0] = float4(0.0f);
-      int first_input_index = is_causal ? 0 : 1;
-      for (int i = 0; i < FILTER_ORDER; i++) {
-        outputs[0] += feedforward_coefficients[i] * inputs[first_input_index + i];
-        outputs[0] -= feedback_coefficients[i] * outputs[i + 1];
-      }
-
-      /* Store the causal and non causal outputs independently, then sum them in a separate shader
-       * dispatch for better parallelism. */
-      if (is_causal) {
-        causal_output.store_pixel(texel, outputs[0]);
-      }
-      else {
-        non_causal_output.store_pixel(texel, outputs[0]);
-      }
-
-      /* Shift the inputs temporally by one. The oldest input is discarded, while the current input
-       * will retain its value but will be overwritten with the new current value in the next
-       * iteration. */
-      for (int i = FILTER_ORDER; i >= 1; i--) {
-        inputs[i] = inputs[i - 1];
-      }
-
-      /* Shift the outputs temporally by one. The oldest output is discarded, while the current
-       * output will retain its value but will be overwritten with the new current value in the
-       * next iteration. */
-      for (int i = FILTER_ORDER; i >= 1; i--) {
-        outputs[i] = outputs[i - 1];
-      }
-    }
+   * The code runs parallel across rows but serially across columns. Unlike the GPU
+   * implementation, the causal and non causal filters of a row run in the same thread and are
+   * summed in a row buffer that is then written transposed to the output, which avoids storing
+   * the outputs of each of the filters in separate images and summing them in a separate pass.
+   * See the DericheGaussianCoefficients class and the implementation for more information. */
+  parallel_for_transposed_rows<float4>(output, [&](const int64_t y, MutableSpan<float4> row) {
+    const Span<float4> input_row = input_data.slice(y * width, width);
+    apply_filter_cpu<true>(input_row,
+                           row,
+                           causal_feedforward_coefficients,
+                           feedback_coefficients,
+                           causal_boundary_coefficient);
+    apply_filter_cpu<false>(input_row,
+                            row,
+                            non_causal_feedforward_coefficients,
+                            feedback_coefficients,
+                            non_causal_boundary_coefficient);
   });
 }
 
 static void blur_pass(Context &context, const Result &input, Result &output, const float sigma)
 {
-  Result causal_result = context.create_result(ResultType::Color);
-  Result non_causal_result = context.create_result(ResultType::Color);
-
   if (context.use_gpu()) {
-    blur_pass_gpu(context, input, causal_result, non_causal_result, sigma);
+    blur_pass_gpu(context, input, output, sigma);
   }
   else {
-    blur_pass_cpu(context, input, causal_result, non_causal_result, sigma);
+    blur_pass_cpu(context, input, output, sigma);
   }
-
-  sum_causal_and_non_causal_results(context, causal_result, non_causal_result, output);
-  causal_result.release();
-  non_causal_result.release();
 }
 
 void deriche_gaussian_blur(Context &context, Result &input, Result &output, float2 sigma)
@@ -2,10 +2,16 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+#include <cstdint>
+
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 
@@ -22,50 +28,62 @@ namespace blender::compositor {
 template<typename T, bool ExtendBounds>
 static void blur_pass(const Result &input, const Result &weights, Result &output)
 {
-  /* Loads the input color of the pixel at the given texel. If bounds are extended, then the input
-   * is treated as padded by a blur size amount of pixels of zero color, and the given texel is
-   * assumed to be in the space of the image after padding. So we offset the texel by the blur
-   * radius amount and fallback to a zero color if it is out of bounds. For instance, if the input
-   * is padded by 5 pixels to the left of the image, the first 5 pixels should be out of bounds and
-   * thus zero, hence the introduced offset. */
-  auto load_input = [&](const int2 texel) {
-    T color;
-    if constexpr (ExtendBounds) {
-      /* Notice that we subtract 1 because the weights result have an extra center weight, see the
-       * SymmetricBlurWeights class for more information. */
-      int2 blur_radius = weights.domain().size - 1;
-      color = input.load_pixel_zero<T>(texel - blur_radius);
-    }
-    else {
-      color = input.load_pixel_extended<T>(texel);
-    }
-
-    return color;
-  };
+  /* Notice that we subtract 1 because the weights result have an extra center weight, see the
+   * SymmetricBlurWeights class for more information. */
+  const int radius = weights.domain().size.x - 1;
+  Array<float> weights_values(radius + 1);
+  for (const int i : weights_values.index_range()) {
+    weights_values[i] = weights.load_pixel<float>(int2(i, 0));
+  }
 
-  /* Notice that the size is transposed, see the note on the horizontal pass method for more
-   * information on the reasoning behind this. */
-  const int2 size = int2(output.domain().size.y, output.domain().size.x);
-  parallel_for(size, [&](const int2 texel) {
-    T accumulated_color = T(0);
+  /* If bounds are extended, then the input is treated as padded by a blur size amount of pixels of
+   * zero color, and the output is larger than the input by that amount. So the output pixels are
+   * offset by the blur radius relative to the input. For instance, if the input is padded by 5
+   * pixels to the left of the image, the first 5 pixels should be out of bounds and thus zero,
+   * hence the introduced offset. */
+  const int offset = ExtendBounds ? radius : 0;
+  const int input_width = input.domain().size.x;
+  const Span<T> input_data = input.cpu_data().typed<T>();
+
+  /* Blur the rows of the input and write them to the output transposed. See the note on the
+   * horizontal pass method for more information on the reasoning behind this. */
+  parallel_for_transposed_rows<T>(output, [&](const int64_t y, MutableSpan<T> output_row) {
+    const Span<T> input_row = input_data.slice(y * input_width, input_width);
+
+    /* Load the input row into a buffer that is additionally padded by the blur radius on both
+     * sides according to the boundary condition, such that the accumulation loops below need not
+     * check for bounds and can access contiguous memory. */
+    Array<T> padded_row(output_row.size() + radius * 2, NoInitialization());
+    for (const int64_t i : padded_row.index_range()) {
+      const int64_t x = i - radius - offset;
+      if constexpr (ExtendBounds) {
+        padded_row[i] = (x >= 0 && x < input_width) ? input_row[x] : T(0);
+      }
+      else {
+        padded_row[i] = input_row[std::clamp(x, int64_t(0), int64_t(input_width - 1))];
+      }
+    }
 
     /* First, compute the contribution of the center pixel. */
-    T center_color = load_input(texel);
-    accumulated_color += center_color * weights.load_pixel<float>(int2(0));
-
-    /* Then, compute the contributions of the pixel to the right and left, noting that the
-     * weights texture only stores the weights for the positive half, but since the filter is
-     * symmetric, the same weight is used for the negative half and we add both of their
-     * contributions. */
-    for (int i = 1; i < weights.domain().size.x; i++) {
-      float weight = weights.load_pixel<float>(int2(i, 0));
-      accumulated_color += load_input(texel + int2(i, 0)) * weight;
-      accumulated_color += load_input(texel + int2(-i, 0)) * weight;
+    const Span<T> center_row = padded_row.as_span().drop_front(radius);
+    for (const int64_t x : output_row.index_range()) {
+      output_row[x] = center_row[x] * weights_values[0];
     }
 
-    /* Write the color using the transposed texel. See the horizontal_pass method for more
-     * information on the rational behind this. */
-    output.store_pixel(int2(texel.y, texel.x), accumulated_color);
+    /* Then, compute the contributions of the pixel to the right and left, noting that the weights
+     * only store the weights for the positive half, but since the filter is symmetric, the same
+     * weight is used for the negative half and we add both of their contributions. The loop over
+     * the weights is the outer loop, such that the inner loops are simple multiply-add loops over
+     * contiguous memory that the compiler can vectorize. */
+    for (const int i : IndexRange(1, radius)) {
+      const float weight = weights_values[i];
+      const Span<T> right_row = padded_row.as_span().drop_front(radius + i);
+      const Span<T> left_row = padded_row.as_span().drop_front(radius - i);
+      for (const int64_t x : output_row.index_range()) {
+        output_row[x] += right_row[x] * weight;
+        output_row[x] += left_row[x] * weight;
+      }
+    }
   });
 }
 
@@ -0,0 +1,113 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_string_ref.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_cached_resource.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+class Context;
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Result Key.
+ *
+ * Identifies an output of a node instance in the node tree. */
+class CachedNodeResultKey {
+ public:
+  uint32_t instance_key;
+  std::string output_identifier;
+
+  CachedNodeResultKey(bNodeInstanceKey instance_key, StringRef output_identifier);
+
+  uint64_t hash() const;
+};
+
+bool operator==(const CachedNodeResultKey &a, const CachedNodeResultKey &b);
+
+/* -------------------------------------------------------------------------------------------------
+ * Cached Node Result.
+ *
+ * A cached resource that stores the result computed by a node operation for one of its outputs,
+ * along with the hash of the node parameters and inputs the result was computed from. The data of
+ * the result is stolen from the output of the operation when it is added to the cache, and the
+ * output then wraps the cached result as external data. */
+class CachedNodeResult : public CachedResource {
+ public:
+  /* The hash of the parameters and inputs of the node that computed the result. */
+  uint64_t inputs_hash;
+  Result result;
+  /* The value of the use counter of the container when the result was last added or retrieved,
+   * used to evict the least recently used results first. */
+  uint64_t last_use = 0;
+
+  CachedNodeResult(Context &context, Result &source, uint64_t inputs_hash);
+
+  ~CachedNodeResult();
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Result Container.
+ *
+ * Only supports CPU results, since computing the content hash of inputs would otherwise require
+ * reading back GPU textures. The total size of the cached results is limited to half the memory
+ * cache limit of the user preferences, leaving the rest to the sequencer cache which shares the
+ * same limit. When adding a result exceeds the budget, the least recently used results that are
+ * not needed by the current evaluation are evicted, and if the result still does not fit, it is
+ * simply not cached. */
+class CachedNodeResultContainer : CachedResourceContainer {
+ private:
+  Map<CachedNodeResultKey, std::unique_ptr<CachedNodeResult>> map_;
+  /* Maps the data of cached results to the hash that identifies their content, such that inputs
+   * that are themselves cached results of upstream nodes need not be hashed again. */
+  Map<const void *, uint64_t> data_hashes_;
+  /* The total size of the data of all cached results in bytes. */
+  int64_t size_in_bytes_ = 0;
+  /* Incremented every time a result is added or retrieved to order results by their last use. */
+  uint64_t use_counter_ = 0;
+
+ public:
+  void reset() override;
+
+  /* Returns the cached result for the given key if one exists and was computed from the given
+   * inputs hash, tagging it as needed to keep it cached for the next evaluation. If the cached
+   * result was computed from different inputs, it is outdated, so it is removed and nullptr is
+   * returned, as is the case if no cached result exists for the key. */
+  Result *get(const CachedNodeResultKey &key, uint64_t inputs_hash);
+
+  /* Steal the data of the given result into a new cached result for the given key and inputs
+   * hash, replacing any existing one, and return the cached result. Least recently used results
+   * might be evicted to make room for the new one. If the result can't be cached because it does
+   * not own its data or because it does not fit in the memory budget, nullptr is returned and the
+   * given result is left untouched. */
+  Result *add(Context &context,
+              const CachedNodeResultKey &key,
+              uint64_t inputs_hash,
+              Result &result);
+
+  /* Compute a hash identifying the content of the given CPU result. If the result wraps the data
+   * of a cached result, the hash of that cached result is returned directly, otherwise, its data
+   * is hashed. */
+  uint64_t compute_result_hash(const Result &result) const;
+
+ private:
+  /* Remove the given cached result from the data hashes and the total size of the container. */
+  void untrack(const CachedNodeResult &cached_result);
+
+  /* Evict the least recently used cached results that are not needed by the current evaluation
+   * until the given number of bytes fits in the memory budget or no such results remain. */
+  void evict_least_recently_used(int64_t size_in_bytes);
+};
+
+}  // namespace blender::compositor
@@ -0,0 +1,225 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "BLI_array.hh"
+#include "BLI_generic_span.hh"
+#include "BLI_hash.hh"
+#include "BLI_index_range.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+#include "COM_cached_node_result.hh"
+#include "COM_context.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+/* --------------------------------------------------------------------
+ * Cached Node Result Key.
+ */
+
+CachedNodeResultKey::CachedNodeResultKey(bNodeInstanceKey instance_key,
+                                         StringRef output_identifier)
+    : instance_key(instance_key.value), output_identifier(output_identifier)
+{
+}
+
+uint64_t CachedNodeResultKey::hash() const
+{
+  return get_default_hash(instance_key, output_identifier);
+}
+
+bool operator==(const CachedNodeResultKey &a, const CachedNodeResultKey &b)
+{
+  return a.instance_key == b.instance_key && a.output_identifier == b.output_identifier;
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Result.
+ */
+
+CachedNodeResult::CachedNodeResult(Context &context, Result &source, uint64_t inputs_hash)
+    : inputs_hash(inputs_hash), result(context, source.type(), source.precision())
+{
+  this->result.steal_data(source);
+}
+
+CachedNodeResult::~CachedNodeResult()
+{
+  this->result.free();
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Result Container.
+ */
+
+/* Hash the given data in parallel in chunks of 1 MiB, then hash the hashes of the chunks. */
+static uint64_t compute_data_hash(const GSpan data)
+{
+  const char *bytes = static_cast<const char *>(data.data());
+  const int64_t size = data.size_in_bytes();
+
+  constexpr int64_t chunk_size = 1 << 20;
+  const int64_t chunks_count = (size + chunk_size - 1) / chunk_size;
+  if (chunks_count <= 1) {
+    return XXH3_64bits(bytes, size);
+  }
+
+  Array<uint64_t> chunk_hashes(chunks_count);
+  threading::parallel_for(IndexRange(chunks_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t i : sub_range) {
+      const int64_t start = i * chunk_size;
+      chunk_hashes[i] = XXH3_64bits(bytes + start, std::min(chunk_size, size - start));
+    }
+  });
+
+  return XXH3_64bits(chunk_hashes.data(), chunk_hashes.as_span().size_in_bytes());
+}
+
+/* Half the memory cache limit, since the limit is shared with the sequencer cache. */
+static int64_t get_memory_budget()
+{
+  return int64_t(U.memcachelimit) * 1024 * 1024 / 2;
+}
+
+void CachedNodeResultContainer::reset()
+{
+  /* First, delete all cached results that are no longer needed. */
+  map_.remove_if([&](auto item) {
+    if (item.value->needed) {
+      return false;
+    }
+    this->untrack(*item.value);
+    return true;
+  });
+
+  /* Second, reset the needed status of the remaining cached results to false to ready them to
+   * track their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+Result *CachedNodeResultContainer::get(const CachedNodeResultKey &key, uint64_t inputs_hash)
+{
+  std::unique_ptr<CachedNodeResult> *cached_result = map_.lookup_ptr(key);
+  if (!cached_result) {
+    return nullptr;
+  }
+
+  /* The node parameters or inputs changed since the result was cached, so it is outdated. */
+  if ((*cached_result)->inputs_hash != inputs_hash) {
+    this->untrack(**cached_result);
+    map_.remove(key);
+    return nullptr;
+  }
+
+  (*cached_result)->needed = true;
+  (*cached_result)->last_use = ++use_counter_;
+  return &(*cached_result)->result;
+}
+
+Result *CachedNodeResultContainer::add(Context &context,
+                                       const CachedNodeResultKey &key,
+                                       uint64_t inputs_hash,
+                                       Result &result)
+{
+  if (context.use_gpu() || !result.is_allocated() || result.is_external() || result.is_proxy()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CachedNodeResult> *existing_result = map_.lookup_ptr(key);
+  if (existing_result) {
+    this->untrack(**existing_result);
+    map_.remove(key);
+  }
+
+  const int64_t size_in_bytes = result.size_in_bytes();
+  if (size_in_bytes > get_memory_budget()) {
+    return nullptr;
+  }
+
+  this->evict_least_recently_used(size_in_bytes);
+  if (size_in_bytes_ + size_in_bytes > get_memory_budget()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CachedNodeResult> cached_result = std::make_unique<CachedNodeResult>(
+      context, result, inputs_hash);
+  cached_result->last_use = ++use_counter_;
+  Result &cached = cached_result->result;
+
+  size_in_bytes_ += size_in_bytes;
+  data_hashes_.add(cached.cpu_data().data(), get_default_hash(inputs_hash, key.output_identifier));
+  map_.add_new(key, std::move(cached_result));
+
+  return &cached;
+}
+
+uint64_t CachedNodeResultContainer::compute_result_hash(const Result &result) const
+{
+  const GSpan data = result.cpu_data();
+  const uint64_t *cached_hash = data_hashes_.lookup_ptr(data.data());
+  const uint64_t data_hash = cached_hash ? *cached_hash : compute_data_hash(data);
+
+  const Domain &domain = result.domain();
+  const uint64_t transformation_hash = XXH3_64bits(&domain.transformation,
+                                                   sizeof(domain.transformation));
+
+  return get_default_hash(get_default_hash(data_hash, transformation_hash),
+                          domain.size,
+                          get_default_hash(int(result.type()), int(result.precision())),
+                          result.is_single_value());
+}
+
+void CachedNodeResultContainer::untrack(const CachedNodeResult &cached_result)
+{
+  if (!cached_result.result.is_allocated()) {
+    return;
+  }
+
+  size_in_bytes_ -= cached_result.result.size_in_bytes();
+  data_hashes_.remove(cached_result.result.cpu_data().data());
+}
+
+void CachedNodeResultContainer::evict_least_recently_used(const int64_t size_in_bytes)
+{
+  const int64_t budget = get_memory_budget();
+  if (size_in_bytes_ + size_in_bytes <= budget) {
+    return;
+  }
+
+  /* Results needed by the current evaluation might be wrapped by its outputs, so they are never
+   * evicted. */
+  Vector<std::pair<uint64_t, CachedNodeResultKey>> candidates;
+  for (const auto item : map_.items()) {
+    if (!item.value->needed) {
+      candidates.append({item.value->last_use, item.key});
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  for (const auto &candidate : candidates) {
+    if (size_in_bytes_ + size_in_bytes <= budget) {
+      break;
+    }
+    this->untrack(*map_.lookup(candidate.second));
+    map_.remove(candidate.second);
+  }
+}
+
+}  // namespace blender::compositor
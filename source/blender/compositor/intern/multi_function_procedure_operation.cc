@@ -14,6 +14,7 @@
 #include "BLI_math_base.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "FN_multi_function.hh"
@@ -139,17 +140,48 @@ static void upload_single_value_output_to_gpu(Result &output)
   }
 }
 
+/* The number of pixels that are evaluated by a single call to the procedure executor for non
+ * single value operations. The executor allocates buffers for all intermediate variables of the
+ * procedure at the size of the evaluated mask, so evaluating in small tiles keeps those buffers in
+ * the CPU cache while they are written and read by the fused multi-functions, as opposed to
+ * streaming them through main memory when evaluating large spans of the domain at once. */
+static constexpr int64_t tile_size = 4096;
+
 void MultiFunctionProcedureOperation::execute()
 {
+  if (this->is_single_value_operation()) {
+    this->execute_single_value();
+    return;
+  }
+
   const Domain domain = compute_domain();
   const int64_t size = int64_t(domain.size.x) * domain.size.y;
-  const IndexMask mask = IndexMask(size);
-  mf::ParamsBuilder parameter_builder{*procedure_executor_, &mask};
 
-  const bool is_single_value = this->is_single_value_operation();
+  /* Allocate the outputs up front, they are written tile by tile below. */
+  for (int i = 0; i < procedure_.params().size(); i++) {
+    if (procedure_.params()[i].type == mf::ParamType::InterfaceType::Output) {
+      get_result(parameter_identifiers_[i]).allocate_texture(domain);
+    }
+  }
+
+  threading::parallel_for(IndexRange(size), tile_size, [&](const IndexRange sub_range) {
+    for (int64_t tile_start = sub_range.start(); tile_start < sub_range.one_after_last();
+         tile_start += tile_size)
+    {
+      const IndexRange tile = IndexRange::from_begin_end(
+          tile_start, math::min(tile_start + tile_size, sub_range.one_after_last()));
+      this->execute_tile(tile);
+    }
+  });
+}
+
+void MultiFunctionProcedureOperation::execute_tile(const IndexRange tile)
+{
+  /* The parameters are sliced to the tile, so the procedure is evaluated on a zero based mask and
+   * intermediate buffers are only allocated at the size of the tile. */
+  const IndexMask mask = IndexMask(tile.size());
+  mf::ParamsBuilder parameter_builder{*procedure_executor_, &mask};
 
-  /* For each of the parameters, either add an input or an output depending on its interface type,
-   * allocating the outputs when needed. */
   for (int i = 0; i < procedure_.params().size(); i++) {
     if (procedure_.params()[i].type == mf::ParamType::InterfaceType::Input) {
       Result &input = get_input(parameter_identifiers_[i]);
@@ -157,26 +189,40 @@ void MultiFunctionProcedureOperation::execute()
         add_single_value_input_parameter(parameter_builder, input);
       }
       else {
-        parameter_builder.add_readonly_single_input(input.cpu_data());
+        parameter_builder.add_readonly_single_input(input.cpu_data().slice(tile));
       }
     }
     else {
       Result &output = get_result(parameter_identifiers_[i]);
-      if (is_single_value) {
-        add_single_value_output_parameter(parameter_builder, output);
-      }
-      else {
-        output.allocate_texture(domain);
-        parameter_builder.add_uninitialized_single_output(output.cpu_data());
-      }
+      parameter_builder.add_uninitialized_single_output(output.cpu_data().slice(tile));
+    }
+  }
+
+  mf::ContextBuilder context_builder;
+  procedure_executor_->call(mask, parameter_builder, context_builder);
+}
+
+void MultiFunctionProcedureOperation::execute_single_value()
+{
+  const IndexMask mask = IndexMask(1);
+  mf::ParamsBuilder parameter_builder{*procedure_executor_, &mask};
+
+  /* For each of the parameters, either add an input or an output depending on its interface type,
+   * allocating the outputs as single values. */
+  for (int i = 0; i < procedure_.params().size(); i++) {
+    if (procedure_.params()[i].type == mf::ParamType::InterfaceType::Input) {
+      add_single_value_input_parameter(parameter_builder, get_input(parameter_identifiers_[i]));
+    }
+    else {
+      add_single_value_output_parameter(parameter_builder, get_result(parameter_identifiers_[i]));
     }
   }
 
   mf::ContextBuilder context_builder;
-  procedure_executor_->call_auto(mask, parameter_builder, context_builder);
+  procedure_executor_->call(mask, parameter_builder, context_builder);
 
   /* In case of single value GPU execution, the single values need to be uploaded to the GPU. */
-  if (is_single_value && this->context().use_gpu()) {
+  if (this->context().use_gpu()) {
     for (int i = 0; i < procedure_.params().size(); i++) {
       if (procedure_.params()[i].type == mf::ParamType::InterfaceType::Output) {
         Result &output = get_result(parameter_identifiers_[i]);
@@ -2,17 +2,30 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cstdint>
+#include <string>
+
+#include <xxhash.h>
+
 #include "BLI_assert.h"
+#include "BLI_hash.hh"
+#include "BLI_index_range.hh"
+#include "BLI_span.hh"
+#include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
+#include "DNA_genfile.h"
 #include "DNA_node_types.h"
+#include "DNA_sdna_types.h"
 
 #include "NOD_derived_node_tree.hh"
 
 #include "BKE_node.hh"
 
 #include "COM_algorithm_compute_preview.hh"
+#include "COM_cached_node_result.hh"
 #include "COM_context.hh"
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
@@ -40,11 +53,20 @@ NodeOperation::NodeOperation(Context &context, DNode node) : Operation(context),
 
 void NodeOperation::evaluate()
 {
+  Profiler *profiler = context().profiler();
+  if (profiler) {
+    profiler->begin_operation_evaluation();
+  }
+
   const timeit::TimePoint before_time = timeit::Clock::now();
   Operation::evaluate();
   const timeit::TimePoint after_time = timeit::Clock::now();
-  if (context().profiler()) {
-    context().profiler()->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+
+  if (profiler) {
+    profiler->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+    const OperationMemoryStatistics memory_statistics = profiler->end_operation_evaluation(
+        node_->name, before_time, after_time);
+    profiler->add_node_memory_statistics(node_.instance_key(), memory_statistics);
   }
 }
 
@@ -55,6 +77,202 @@ void NodeOperation::compute_preview()
   }
 }
 
+bool NodeOperation::load_cached_results()
+{
+  inputs_hash_.reset();
+  if (!this->is_cacheable()) {
+    return false;
+  }
+
+  inputs_hash_ = this->compute_inputs_hash();
+
+  /* Only use the cached results if all needed outputs are cached, otherwise, the node needs to be
+   * executed anyways. */
+  CachedNodeResultContainer &cache = this->context().cache_manager().cached_node_results;
+  Vector<std::pair<Result *, Result *>> cached_outputs;
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = this->get_result(output->identifier);
+    if (!result.should_compute()) {
+      continue;
+    }
+
+    const CachedNodeResultKey key(node_.instance_key(), output->identifier);
+    Result *cached_result = cache.get(key, inputs_hash_.value());
+    if (!cached_result || cached_result->type() != result.type() ||
+        cached_result->precision() != result.precision())
+    {
+      return false;
+    }
+
+    cached_outputs.append({&result, cached_result});
+  }
+
+  if (cached_outputs.is_empty()) {
+    return false;
+  }
+
+  for (const auto &[result, cached_result] : cached_outputs) {
+    result->wrap_external(*cached_result);
+  }
+
+  return true;
+}
+
+void NodeOperation::store_cached_results()
+{
+  if (!inputs_hash_) {
+    return;
+  }
+
+  CachedNodeResultContainer &cache = this->context().cache_manager().cached_node_results;
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = this->get_result(output->identifier);
+    if (!result.should_compute()) {
+      continue;
+    }
+
+    /* The cache steals the data of the result, so wrap the cached result back. */
+    const CachedNodeResultKey key(node_.instance_key(), output->identifier);
+    Result *cached_result = cache.add(this->context(), key, inputs_hash_.value(), result);
+    if (cached_result) {
+      result.wrap_external(*cached_result);
+    }
+  }
+}
+
+/* Returns the index of the DNA struct of the node storage, or -1 if the storage is not DNA. */
+static int get_storage_struct_index(const bNode &node)
+{
+  const std::string &storage_name = node.typeinfo->storagename;
+  if (storage_name.empty()) {
+    return -1;
+  }
+  return DNA_struct_find_with_alias(DNA_sdna_current_get(), storage_name.c_str());
+}
+
+/* Hashes the members of the given DNA struct. Pointers are skipped since their values change
+ * between evaluations without the data changing, and so is explicit padding, which might not be
+ * initialized. Structs are hashed recursively. */
+static uint64_t hash_dna_struct(const SDNA &sdna,
+                                const SDNA_Struct &sdna_struct,
+                                const void *data,
+                                uint64_t hash)
+{
+  const char *member_data = static_cast<const char *>(data);
+  for (const int i : IndexRange(sdna_struct.members_num)) {
+    const SDNA_StructMember &member = sdna_struct.members[i];
+    const char *member_name = sdna.members[member.member_index];
+    const int member_size = DNA_struct_member_size(&sdna, member.type_index, member.member_index);
+
+    const bool is_pointer = member_name[0] == '*' || member_name[0] == '(';
+    if (!is_pointer && !StringRef(member_name).startswith("_pad")) {
+      const int substruct_index = DNA_struct_find_index_without_alias(
+          &sdna, sdna.types[member.type_index]);
+      if (substruct_index == -1) {
+        hash = XXH3_64bits_withSeed(member_data, member_size, hash);
+      }
+      else {
+        const int substruct_size = sdna.types_size[member.type_index];
+        for (const int j : IndexRange(sdna.members_array_num[member.member_index])) {
+          hash = hash_dna_struct(
+              sdna, *sdna.structs[substruct_index], member_data + j * substruct_size, hash);
+        }
+      }
+    }
+
+    member_data += member_size;
+  }
+  return hash;
+}
+
+bool NodeOperation::is_cacheable() const
+{
+  /* Computing the hash of the inputs would require reading back GPU textures. */
+  if (this->context().use_gpu()) {
+    return false;
+  }
+
+  /* Only cache for interactive evaluation in the node editor, where the same node tree is evaluated
+   * repeatedly with few changes. Renders evaluate each frame once, so caching would only hold on to
+   * memory that is never reused. */
+  if (this->context().render_context()) {
+    return false;
+  }
+
+  const bNode &node = this->bnode();
+  if (node.id || node.output_sockets().is_empty()) {
+    return false;
+  }
+
+  /* Cryptomatte nodes store their matte identifiers outside of the node storage. */
+  if (StringRef(node.idname).startswith("CompositorNodeCryptomatte")) {
+    return false;
+  }
+
+  /* Nodes that read the scene, its camera or the current frame, none of which is part of the
+   * inputs hash. The defocus node reads the scene camera even when no scene is assigned. */
+  if (STR_ELEM(
+          node.idname, "CompositorNodeDefocus", "CompositorNodeTime", "CompositorNodeSceneTime"))
+  {
+    return false;
+  }
+
+  /* The storage is hashed through its DNA members, which is not possible for non-DNA storage. */
+  if (node.storage && get_storage_struct_index(node) == -1) {
+    return false;
+  }
+
+  for (const bNodeSocket *input : node.input_sockets()) {
+    const DInputSocket dinput{node_.context(), input};
+    if (input->is_available() && get_input_origin_socket(dinput)->is_output()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+uint64_t NodeOperation::compute_inputs_hash()
+{
+  const bNode &node = this->bnode();
+  Vector<const Result *> inputs;
+  for (const bNodeSocket *input : node.input_sockets()) {
+    inputs.append(&this->get_input(input->identifier));
+  }
+  return compute_node_inputs_hash(this->context(), node, inputs);
+}
+
+uint64_t compute_node_inputs_hash(Context &context, const bNode &node, Span<const Result *> inputs)
+{
+  uint64_t hash = get_default_hash(StringRef(node.idname),
+                                   node.custom1,
+                                   node.custom2,
+                                   get_default_hash(node.custom3, node.custom4));
+
+  /* Data referenced by pointers in the storage is not hashed. Such data, like curve mappings,
+   * typically store an inline change time stamp that is updated on changes. */
+  if (node.storage) {
+    const SDNA &sdna = *DNA_sdna_current_get();
+    const SDNA_Struct &sdna_struct = *sdna.structs[get_storage_struct_index(node)];
+    hash = hash_dna_struct(sdna, sdna_struct, node.storage, hash);
+  }
+
+  hash = get_default_hash(hash,
+                          context.get_view_name(),
+                          context.get_compositing_region_size(),
+                          get_default_hash(context.get_render_percentage(),
+                                           int(context.get_denoise_quality())));
+
+  const CachedNodeResultContainer &cache = context.cache_manager().cached_node_results;
+  for (const Result *input_result : inputs) {
+    if (input_result->is_allocated()) {
+      hash = get_default_hash(hash, cache.compute_result_hash(*input_result));
+    }
+  }
+
+  return hash;
+}
+
 Result *NodeOperation::get_preview_result()
 {
   /* Find the first linked output. */
@@ -30,7 +30,10 @@ void Operation::evaluate()
 
   reset_results();
 
-  execute();
+  if (!this->load_cached_results()) {
+    execute();
+    this->store_cached_results();
+  }
 
   compute_preview();
 
@@ -146,6 +149,13 @@ void Operation::add_and_evaluate_input_processor(StringRef identifier, SimpleOpe
 
 void Operation::compute_preview(){};
 
+bool Operation::load_cached_results()
+{
+  return false;
+}
+
+void Operation::store_cached_results() {}
+
 Result &Operation::get_input(StringRef identifier) const
 {
   return *results_mapped_to_inputs_.lookup(identifier);
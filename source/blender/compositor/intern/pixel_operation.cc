@@ -7,6 +7,7 @@
 
 #include "BLI_map.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_timeit.hh"
 
 #include "NOD_derived_node_tree.hh"
 
@@ -15,6 +16,7 @@
 #include "COM_multi_function_procedure_operation.hh"
 #include "COM_operation.hh"
 #include "COM_pixel_operation.hh"
+#include "COM_profiler.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
@@ -42,6 +44,27 @@ int PixelOperation::maximum_number_of_outputs(Context &context)
   return std::numeric_limits<int>::max();
 }
 
+void PixelOperation::evaluate()
+{
+  Profiler *profiler = context().profiler();
+  if (!profiler) {
+    Operation::evaluate();
+    return;
+  }
+
+  profiler->begin_operation_evaluation();
+  const timeit::TimePoint before_time = timeit::Clock::now();
+  Operation::evaluate();
+  const timeit::TimePoint after_time = timeit::Clock::now();
+
+  /* Pixel operations are not tied to a single node, so name them after the nodes they contain. */
+  std::string name = "Pixel Operation:";
+  for (const DNode &node : compile_unit_) {
+    name += " " + std::string(node->name);
+  }
+  profiler->end_operation_evaluation(name, before_time, after_time);
+}
+
 void PixelOperation::compute_preview()
 {
   for (const DOutputSocket &output : preview_outputs_) {
@@ -2,6 +2,16 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "BLI_fileops.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
@@ -25,6 +35,72 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+Map<bNodeInstanceKey, OperationMemoryStatistics> &Profiler::get_nodes_memory_statistics()
+{
+  return nodes_memory_statistics_;
+}
+
+void Profiler::add_node_memory_statistics(bNodeInstanceKey node_instance_key,
+                                          const OperationMemoryStatistics &statistics)
+{
+  OperationMemoryStatistics &node_statistics = nodes_memory_statistics_.lookup_or_add_default(
+      node_instance_key);
+  node_statistics.allocated_bytes += statistics.allocated_bytes;
+  node_statistics.peak_live_bytes = std::max(node_statistics.peak_live_bytes,
+                                             statistics.peak_live_bytes);
+}
+
+void Profiler::add_result_allocation(int64_t size_in_bytes)
+{
+  std::scoped_lock lock(memory_mutex_);
+  live_bytes_ += size_in_bytes;
+  current_memory_statistics_.allocated_bytes += size_in_bytes;
+  current_memory_statistics_.peak_live_bytes = std::max(current_memory_statistics_.peak_live_bytes,
+                                                        live_bytes_);
+}
+
+void Profiler::add_result_free(int64_t size_in_bytes)
+{
+  std::scoped_lock lock(memory_mutex_);
+  /* Results that were allocated before the profiler was created, like cached results, might be
+   * freed during profiling, so clamp to zero. */
+  live_bytes_ = std::max(int64_t(0), live_bytes_ - size_in_bytes);
+}
+
+void Profiler::begin_operation_evaluation()
+{
+  std::scoped_lock lock(memory_mutex_);
+  current_memory_statistics_.allocated_bytes = 0;
+  current_memory_statistics_.peak_live_bytes = live_bytes_;
+}
+
+OperationMemoryStatistics Profiler::end_operation_evaluation(StringRef name,
+                                                             timeit::TimePoint start,
+                                                             timeit::TimePoint end)
+{
+  ProfilerTimelineEvent event;
+  event.name = name;
+  event.start = start;
+  event.end = end;
+
+  const size_t thread_hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+  event.thread = thread_indices_.lookup_or_add(thread_hash, thread_indices_.size());
+
+  {
+    std::scoped_lock lock(memory_mutex_);
+    event.memory = current_memory_statistics_;
+    event.live_bytes = live_bytes_;
+  }
+
+  timeline_.append(event);
+  return event.memory;
+}
+
+Span<ProfilerTimelineEvent> Profiler::get_timeline() const
+{
+  return timeline_;
+}
+
 timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
                                                           bNodeInstanceKey instance_key)
 {
@@ -68,4 +144,65 @@ void Profiler::finalize(const bNodeTree &node_tree)
   this->accumulate_node_group_times(node_tree, bke::NODE_INSTANCE_KEY_BASE);
 }
 
+/* Get the time of the given time point in microseconds relative to the given origin, which is the
+ * unit of time stamps in the Trace Event Format. */
+static int64_t get_trace_time(timeit::TimePoint time, timeit::TimePoint origin)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+}
+
+/* Escape the characters that are not allowed in JSON strings, node names are user defined. */
+static std::string escape_trace_string(StringRef string)
+{
+  std::string result;
+  for (const char c : string) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if (uint8_t(c) < 0x20) {
+      result += fmt::format("\\u{:04x}", int(c));
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+bool Profiler::write_trace(StringRefNull filepath) const
+{
+  blender::fstream file(filepath.c_str(), std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  file << R"([{"name":"process_name","ph":"M","pid":1,"args":{"name":"Compositor"}})";
+
+  for (const ProfilerTimelineEvent &event : timeline_) {
+    const int64_t start = get_trace_time(event.start, creation_time_);
+    const int64_t end = get_trace_time(event.end, creation_time_);
+
+    file << fmt::format(
+        ",\n"
+        R"({{"name":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":{},)"
+        R"("args":{{"allocated_bytes":{},"peak_live_bytes":{}}}}})",
+        escape_trace_string(event.name),
+        start,
+        end - start,
+        event.thread,
+        event.memory.allocated_bytes,
+        event.memory.peak_live_bytes);
+
+    file << fmt::format(
+        ",\n"
+        R"({{"name":"Live Result Memory","ph":"C","ts":{},"pid":1,"args":{{"bytes":{}}}}})",
+        end,
+        event.live_bytes);
+  }
+
+  file << "\n]\n";
+  return file.good();
+}
+
 }  // namespace blender::compositor
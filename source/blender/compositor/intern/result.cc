@@ -272,6 +272,10 @@ void Result::allocate_texture(Domain domain, bool from_pool)
   is_single_value_ = false;
   this->allocate_data(domain.size, from_pool);
   domain_ = domain;
+
+  if (context_->profiler()) {
+    context_->profiler()->add_result_allocation(this->size_in_bytes());
+  }
 }
 
 void Result::allocate_single_value()
@@ -282,6 +286,10 @@ void Result::allocate_single_value()
   this->allocate_data(int2(1), true);
   domain_ = Domain::identity();
 
+  if (context_->profiler()) {
+    context_->profiler()->add_result_allocation(this->size_in_bytes());
+  }
+
   /* It is important that we initialize single values because the variant member that stores single
    * values need to have its type initialized. */
   switch (type_) {
@@ -521,6 +529,10 @@ void Result::free()
     return;
   }
 
+  if (context_->profiler()) {
+    context_->profiler()->add_result_free(this->size_in_bytes());
+  }
+
   switch (storage_type_) {
     case ResultStorageType::GPU:
       if (is_from_pool_) {
@@ -595,6 +607,34 @@ bool Result::is_allocated() const
   return false;
 }
 
+int64_t Result::size_in_bytes() const
+{
+  if (!this->is_allocated()) {
+    return 0;
+  }
+
+  switch (storage_type_) {
+    case ResultStorageType::GPU: {
+      const int64_t channel_size = precision_ == ResultPrecision::Half ? 2 : 4;
+      return int64_t(domain_.size.x) * domain_.size.y * this->channels_count() * channel_size;
+    }
+    case ResultStorageType::CPU:
+      return this->cpu_data().size_in_bytes();
+  }
+
+  return 0;
+}
+
+bool Result::is_external() const
+{
+  return is_external_;
+}
+
+bool Result::is_proxy() const
+{
+  return master_ != nullptr;
+}
+
 int Result::reference_count() const
 {
   /* If there is a master result, return its reference count instead. */
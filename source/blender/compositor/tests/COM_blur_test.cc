@@ -0,0 +1,334 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstdint>
+
+#include "BLI_index_range.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_scene_types.h"
+
+#include "COM_domain.hh"
+#include "COM_result.hh"
+#include "COM_utilities.hh"
+
+#include "COM_algorithm_deriche_gaussian_blur.hh"
+#include "COM_algorithm_symmetric_separable_blur.hh"
+#include "COM_algorithm_van_vliet_gaussian_blur.hh"
+#include "COM_deriche_gaussian_coefficients.hh"
+#include "COM_symmetric_separable_blur_weights.hh"
+#include "COM_van_vliet_gaussian_coefficients.hh"
+
+#include "COM_test_context.hh"
+
+namespace blender::compositor::tests {
+
+/* The blur algorithms work on whole rows of the image. The functions below are the previous
+ * implementations that computed each pixel independently, which the results are compared to. */
+
+/* The previous per pixel implementation of the blur pass of the symmetric separable blur, which
+ * blurs the input horizontally and writes the result transposed. */
+template<typename T, bool ExtendBounds>
+static void reference_separable_blur_pass(const Result &input,
+                                          const Result &weights,
+                                          Result &output)
+{
+  auto load_input = [&](const int2 texel) {
+    if constexpr (ExtendBounds) {
+      const int2 blur_radius = weights.domain().size - 1;
+      return input.load_pixel_zero<T>(texel - blur_radius);
+    }
+    else {
+      return input.load_pixel_extended<T>(texel);
+    }
+  };
+
+  const int2 size = int2(output.domain().size.y, output.domain().size.x);
+  parallel_for(size, [&](const int2 texel) {
+    T accumulated_color = T(0);
+    accumulated_color += load_input(texel) * weights.load_pixel<float>(int2(0));
+    for (int i = 1; i < weights.domain().size.x; i++) {
+      const float weight = weights.load_pixel<float>(int2(i, 0));
+      accumulated_color += load_input(texel + int2(i, 0)) * weight;
+      accumulated_color += load_input(texel + int2(-i, 0)) * weight;
+    }
+    output.store_pixel(int2(texel.y, texel.x), accumulated_color);
+  });
+}
+
+template<typename T>
+static void reference_symmetric_separable_blur(Context &context,
+                                               const Result &input,
+                                               Result &output,
+                                               const float2 radius,
+                                               const int filter_type,
+                                               const bool extend_bounds)
+{
+  const Result &horizontal_weights = context.cache_manager().symmetric_separable_blur_weights.get(
+      context, filter_type, radius.x);
+  Domain horizontal_domain = input.domain();
+  if (extend_bounds) {
+    horizontal_domain.size.x += int(math::ceil(radius.x)) * 2;
+  }
+  Result horizontal_pass_result = context.create_result(input.type());
+  horizontal_pass_result.allocate_texture(
+      int2(horizontal_domain.size.y, horizontal_domain.size.x));
+
+  const Result &vertical_weights = context.cache_manager().symmetric_separable_blur_weights.get(
+      context, filter_type, radius.y);
+  Domain vertical_domain = input.domain();
+  if (extend_bounds) {
+    vertical_domain.size += int2(math::ceil(radius)) * 2;
+  }
+  output.allocate_texture(vertical_domain);
+
+  if (extend_bounds) {
+    reference_separable_blur_pass<T, true>(input, horizontal_weights, horizontal_pass_result);
+    reference_separable_blur_pass<T, true>(horizontal_pass_result, vertical_weights, output);
+  }
+  else {
+    reference_separable_blur_pass<T, false>(input, horizontal_weights, horizontal_pass_result);
+    reference_separable_blur_pass<T, false>(horizontal_pass_result, vertical_weights, output);
+  }
+  horizontal_pass_result.release();
+}
+
+/* The coefficients of one of the causal or non causal filters of a recursive blur. Only the first
+ * order coefficients are used. */
+struct ReferenceRecursiveFilter {
+  int order;
+  bool is_causal;
+  float4 feedforward_coefficients;
+  float4 feedback_coefficients;
+  float boundary_coefficient;
+};
+
+/* The previous implementation of the blur pass of the recursive blurs, which computes each filter
+ * into its own image and sums them into the output transposed in a separate pass. */
+static void reference_recursive_blur_pass(Context &context,
+                                          const Result &input,
+                                          Result &output,
+                                          const Span<ReferenceRecursiveFilter> filters)
+{
+  const Domain domain = input.domain();
+  Vector<Result> filter_outputs;
+  for (const ReferenceRecursiveFilter &filter : filters) {
+    Result filter_output = context.create_result(ResultType::Color);
+    filter_output.allocate_texture(domain);
+
+    parallel_for(int2(1, domain.size.y), [&](const int2 invocation) {
+      const int y = invocation.y;
+      const int width = domain.size.x;
+      const int2 boundary_texel = filter.is_causal ? int2(0, y) : int2(width - 1, y);
+      const float4 input_boundary = input.load_pixel<float4>(boundary_texel);
+      const float4 output_boundary = input_boundary * filter.boundary_coefficient;
+      float4 inputs[5] = {
+          input_boundary, input_boundary, input_boundary, input_boundary, input_boundary};
+      float4 outputs[5] = {
+          output_boundary, output_boundary, output_boundary, output_boundary, output_boundary};
+
+      for (int x = 0; x < width; x++) {
+        const int2 texel = filter.is_causal ? int2(x, y) : int2(width - 1 - x, y);
+        inputs[0] = input.load_pixel<float4>(texel);
+
+        outputs[0] = float4(0.0f);
+        const int first_input_index = filter.is_causal ? 0 : 1;
+        for (int i = 0; i < filter.order; i++) {
+          outputs[0] += filter.feedforward_coefficients[i] * inputs[first_input_index + i];
+          outputs[0] -= filter.feedback_coefficients[i] * outputs[i + 1];
+        }
+        filter_output.store_pixel(texel, outputs[0]);
+
+        for (int i = filter.order; i >= 1; i--) {
+          inputs[i] = inputs[i - 1];
+          outputs[i] = outputs[i - 1];
+        }
+      }
+    });
+
+    filter_outputs.append(filter_output);
+  }
+
+  output.allocate_texture(int2(domain.size.y, domain.size.x));
+  parallel_for(domain.size, [&](const int2 texel) {
+    float4 filter_output = filter_outputs[0].load_pixel<float4>(texel);
+    for (const int i : filter_outputs.index_range().drop_front(1)) {
+      filter_output = filter_output + filter_outputs[i].load_pixel<float4>(texel);
+    }
+    output.store_pixel(int2(texel.y, texel.x), filter_output);
+  });
+
+  for (Result &filter_output : filter_outputs) {
+    filter_output.release();
+  }
+}
+
+static Vector<ReferenceRecursiveFilter> get_deriche_filters(Context &context, const float sigma)
+{
+  const DericheGaussianCoefficients &coefficients =
+      context.cache_manager().deriche_gaussian_coefficients.get(context, sigma);
+  const float4 feedback_coefficients = float4(coefficients.feedback_coefficients());
+  return {{4,
+           true,
+           float4(coefficients.causal_feedforward_coefficients()),
+           feedback_coefficients,
+           float(coefficients.causal_boundary_coefficient())},
+          {4,
+           false,
+           float4(coefficients.non_causal_feedforward_coefficients()),
+           feedback_coefficients,
+           float(coefficients.non_causal_boundary_coefficient())}};
+}
+
+static Vector<ReferenceRecursiveFilter> get_van_vliet_filters(Context &context, const float sigma)
+{
+  const VanVlietGaussianCoefficients &coefficients =
+      context.cache_manager().van_vliet_gaussian_coefficients.get(context, sigma);
+  const float2 first_feedback = float2(coefficients.first_feedback_coefficients());
+  const float2 second_feedback = float2(coefficients.second_feedback_coefficients());
+  const float2 first_causal = float2(coefficients.first_causal_feedforward_coefficients());
+  const float2 first_non_causal = float2(coefficients.first_non_causal_feedforward_coefficients());
+  const float2 second_causal = float2(coefficients.second_causal_feedforward_coefficients());
+  const float2 second_non_causal = float2(
+      coefficients.second_non_causal_feedforward_coefficients());
+  return {{2,
+           true,
+           float4(first_causal, 0.0f, 0.0f),
+           float4(first_feedback, 0.0f, 0.0f),
+           float(coefficients.first_causal_boundary_coefficient())},
+          {2,
+           false,
+           float4(first_non_causal, 0.0f, 0.0f),
+           float4(first_feedback, 0.0f, 0.0f),
+           float(coefficients.first_non_causal_boundary_coefficient())},
+          {2,
+           true,
+           float4(second_causal, 0.0f, 0.0f),
+           float4(second_feedback, 0.0f, 0.0f),
+           float(coefficients.second_causal_boundary_coefficient())},
+          {2,
+           false,
+           float4(second_non_causal, 0.0f, 0.0f),
+           float4(second_feedback, 0.0f, 0.0f),
+           float(coefficients.second_non_causal_boundary_coefficient())}};
+}
+
+static Result create_input_image(Context &context, const ResultType type, const int2 size)
+{
+  Result image = context.create_result(type);
+  image.allocate_texture(Domain(size));
+  float *data = static_cast<float *>(image.cpu_data().data());
+  const int64_t values_count = int64_t(size.x) * size.y * image.channels_count();
+  for (const int64_t i : IndexRange(values_count)) {
+    /* Include sharp edges and negative values. */
+    data[i] = (i % 7 == 0 ? -0.5f : 0.0f) + float((i * 37) % 101) / 100.0f;
+  }
+  return image;
+}
+
+static void expect_results_near(const Result &a, const Result &b, const float tolerance)
+{
+  ASSERT_EQ(a.domain().size, b.domain().size);
+  ASSERT_EQ(a.channels_count(), b.channels_count());
+  const Span<float> a_data = a.cpu_data().typed<float>();
+  const Span<float> b_data = b.cpu_data().typed<float>();
+  for (const int64_t i : a_data.index_range()) {
+    EXPECT_NEAR(a_data[i], b_data[i], tolerance) << "Index " << i;
+  }
+}
+
+/* Non square sizes with odd dimensions, such that the transposed blocks of rows do not divide the
+ * images evenly. */
+static const int2 sizes[] = {int2(37, 23), int2(23, 37), int2(1, 19)};
+
+TEST(compositor_blur, symmetric_separable_blur_matches_reference)
+{
+  TestContext context;
+  for (const int2 size : sizes) {
+    for (const bool extend_bounds : {false, true}) {
+      for (const int filter_type : {R_FILTER_GAUSS, R_FILTER_BOX}) {
+        for (const ResultType type : {ResultType::Float, ResultType::Color}) {
+          const float2 radius = float2(3.5f, 6.0f);
+          Result input = create_input_image(context, type, size);
+
+          Result output = context.create_result(type);
+          symmetric_separable_blur(context, input, output, radius, filter_type, extend_bounds);
+
+          Result reference = context.create_result(type);
+          if (type == ResultType::Float) {
+            reference_symmetric_separable_blur<float>(
+                context, input, reference, radius, filter_type, extend_bounds);
+          }
+          else {
+            reference_symmetric_separable_blur<float4>(
+                context, input, reference, radius, filter_type, extend_bounds);
+          }
+
+          expect_results_near(output, reference, 1e-5f);
+          input.release();
+          output.release();
+          reference.release();
+        }
+      }
+    }
+  }
+}
+
+TEST(compositor_blur, deriche_gaussian_blur_matches_reference)
+{
+  TestContext context;
+  for (const int2 size : sizes) {
+    const float2 sigma = float2(5.0f, 9.5f);
+    Result input = create_input_image(context, ResultType::Color, size);
+
+    Result output = context.create_result(ResultType::Color);
+    deriche_gaussian_blur(context, input, output, sigma);
+
+    Result horizontal_pass_result = context.create_result(ResultType::Color);
+    Result reference = context.create_result(ResultType::Color);
+    reference_recursive_blur_pass(
+        context, input, horizontal_pass_result, get_deriche_filters(context, sigma.x));
+    reference_recursive_blur_pass(
+        context, horizontal_pass_result, reference, get_deriche_filters(context, sigma.y));
+
+    expect_results_near(output, reference, 1e-4f);
+    input.release();
+    output.release();
+    horizontal_pass_result.release();
+    reference.release();
+  }
+}
+
+TEST(compositor_blur, van_vliet_gaussian_blur_matches_reference)
+{
+  TestContext context;
+  for (const int2 size : sizes) {
+    const float2 sigma = float2(33.0f, 48.0f);
+    Result input = create_input_image(context, ResultType::Color, size);
+
+    Result output = context.create_result(ResultType::Color);
+    van_vliet_gaussian_blur(context, input, output, sigma);
+
+    Result horizontal_pass_result = context.create_result(ResultType::Color);
+    Result reference = context.create_result(ResultType::Color);
+    reference_recursive_blur_pass(
+        context, input, horizontal_pass_result, get_van_vliet_filters(context, sigma.x));
+    reference_recursive_blur_pass(
+        context, horizontal_pass_result, reference, get_van_vliet_filters(context, sigma.y));
+
+    expect_results_near(output, reference, 1e-4f);
+    input.release();
+    output.release();
+    horizontal_pass_result.release();
+    reference.release();
+  }
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,176 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstdint>
+
+#include "BLI_string.h"
+
+#include "DNA_genfile.h"
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_node.hh"
+
+#include "COM_cached_node_result.hh"
+#include "COM_domain.hh"
+#include "COM_node_operation.hh"
+#include "COM_result.hh"
+
+#include "COM_test_context.hh"
+
+namespace blender::compositor::tests {
+
+class NodeResultCacheTest : public ::testing::Test {
+ public:
+  TestContext context;
+  bke::bNodeType node_type;
+  bNode node = {};
+  NodeDBlurData storage = {};
+  int memcachelimit;
+
+  static void SetUpTestSuite()
+  {
+    DNA_sdna_current_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    DNA_sdna_current_free();
+  }
+
+  void SetUp() override
+  {
+    memcachelimit = U.memcachelimit;
+    U.memcachelimit = 64;
+    context.render_data.size = 100;
+
+    node_type.storagename = "NodeDBlurData";
+    node.typeinfo = &node_type;
+    STRNCPY(node.idname, "CompositorNodeDBlur");
+    node.storage = &storage;
+    storage.distance = 0.5f;
+    storage.iter = 4;
+  }
+
+  void TearDown() override
+  {
+    U.memcachelimit = memcachelimit;
+  }
+
+  Result create_image(const float value)
+  {
+    Result image = context.create_result(ResultType::Color);
+    image.allocate_texture(Domain(int2(7, 5)));
+    float *data = static_cast<float *>(image.cpu_data().data());
+    for (const int64_t i : IndexRange(int64_t(7) * 5 * 4)) {
+      data[i] = value + float(i) / 140.0f;
+    }
+    return image;
+  }
+};
+
+TEST_F(NodeResultCacheTest, unchanged_node_hits)
+{
+  Result image = create_image(0.0f);
+  const uint64_t hash = compute_node_inputs_hash(context, node, {&image});
+  EXPECT_EQ(hash, compute_node_inputs_hash(context, node, {&image}));
+
+  /* An identical image in different memory has the same hash. */
+  Result same_image = create_image(0.0f);
+  EXPECT_EQ(hash, compute_node_inputs_hash(context, node, {&same_image}));
+
+  CachedNodeResultContainer &cache = context.cache_manager().cached_node_results;
+  const CachedNodeResultKey key(bNodeInstanceKey{1}, "Image");
+  Result output = create_image(1.0f);
+  ASSERT_NE(cache.add(context, key, hash, output), nullptr);
+  EXPECT_NE(cache.get(key, hash), nullptr);
+
+  image.release();
+  same_image.release();
+  output.release();
+}
+
+TEST_F(NodeResultCacheTest, changed_input_misses)
+{
+  Result image = create_image(0.0f);
+  const uint64_t hash = compute_node_inputs_hash(context, node, {&image});
+
+  static_cast<float *>(image.cpu_data().data())[17] += 0.25f;
+  const uint64_t changed_hash = compute_node_inputs_hash(context, node, {&image});
+  EXPECT_NE(hash, changed_hash);
+
+  CachedNodeResultContainer &cache = context.cache_manager().cached_node_results;
+  const CachedNodeResultKey key(bNodeInstanceKey{1}, "Image");
+  Result output = create_image(1.0f);
+  ASSERT_NE(cache.add(context, key, hash, output), nullptr);
+  EXPECT_EQ(cache.get(key, changed_hash), nullptr);
+  /* The outdated result was removed. */
+  EXPECT_EQ(cache.get(key, hash), nullptr);
+
+  image.release();
+  output.release();
+}
+
+TEST_F(NodeResultCacheTest, changed_dna_setting_misses)
+{
+  Result image = create_image(0.0f);
+  const uint64_t hash = compute_node_inputs_hash(context, node, {&image});
+
+  storage.iter = 5;
+  const uint64_t changed_hash = compute_node_inputs_hash(context, node, {&image});
+  EXPECT_NE(hash, changed_hash);
+
+  /* Padding is not part of the hash. */
+  storage._pad[0] = 1;
+  EXPECT_EQ(changed_hash, compute_node_inputs_hash(context, node, {&image}));
+
+  node.custom1 = 3;
+  EXPECT_NE(changed_hash, compute_node_inputs_hash(context, node, {&image}));
+  node.custom1 = 0;
+
+  context.render_data.size = 50;
+  EXPECT_NE(changed_hash, compute_node_inputs_hash(context, node, {&image}));
+
+  image.release();
+}
+
+TEST_F(NodeResultCacheTest, changed_upstream_image_misses)
+{
+  CachedNodeResultContainer &cache = context.cache_manager().cached_node_results;
+  const CachedNodeResultKey upstream_key(bNodeInstanceKey{1}, "Image");
+  const CachedNodeResultKey key(bNodeInstanceKey{2}, "Image");
+
+  /* The input of the node is the cached result of an upstream node, which is identified by the
+   * hash of the upstream node inputs rather than its content. */
+  Result upstream_output = create_image(0.0f);
+  Result *upstream_cached = cache.add(context, upstream_key, 1, upstream_output);
+  ASSERT_NE(upstream_cached, nullptr);
+  Result input = context.create_result(ResultType::Color);
+  input.wrap_external(*upstream_cached);
+  const uint64_t hash = compute_node_inputs_hash(context, node, {&input});
+  EXPECT_EQ(hash, compute_node_inputs_hash(context, node, {&input}));
+
+  Result output = create_image(1.0f);
+  ASSERT_NE(cache.add(context, key, hash, output), nullptr);
+  EXPECT_NE(cache.get(key, hash), nullptr);
+
+  /* The upstream node is evaluated again with different inputs. */
+  EXPECT_EQ(cache.get(upstream_key, 2), nullptr);
+  Result new_upstream_output = create_image(0.5f);
+  upstream_cached = cache.add(context, upstream_key, 2, new_upstream_output);
+  ASSERT_NE(upstream_cached, nullptr);
+  Result new_input = context.create_result(ResultType::Color);
+  new_input.wrap_external(*upstream_cached);
+  const uint64_t changed_hash = compute_node_inputs_hash(context, node, {&new_input});
+  EXPECT_NE(hash, changed_hash);
+  EXPECT_EQ(cache.get(key, changed_hash), nullptr);
+
+  upstream_output.release();
+  new_upstream_output.release();
+  output.release();
+}
+
+}  // namespace blender::compositor::tests
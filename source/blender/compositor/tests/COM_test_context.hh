@@ -0,0 +1,105 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_rect.h"
+#include "BLI_string_ref.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor::tests {
+
+/* A minimal CPU context that only supports what is needed to evaluate algorithms and
+ * cached resources in tests. */
+class TestContext : public Context {
+ private:
+  Scene scene_ = {};
+  bNodeTree node_tree_ = {};
+
+ public:
+  RenderData render_data = {};
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  const bNodeTree &get_node_tree() const override
+  {
+    return node_tree_;
+  }
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+
+  eCompositorDenoiseQaulity get_denoise_quality() const override
+  {
+    return SCE_COMPOSITOR_DENOISE_BALANCED;
+  }
+
+  OutputTypes needed_outputs() const override
+  {
+    return OutputTypes::None;
+  }
+
+  const RenderData &get_render_data() const override
+  {
+    return render_data;
+  }
+
+  int2 get_render_size() const override
+  {
+    return int2(0);
+  }
+
+  rcti get_compositing_region() const override
+  {
+    return rcti{0, 0, 0, 0};
+  }
+
+  Result get_output_result() override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_viewer_output_result(Domain /*domain*/,
+                                  bool /*is_data*/,
+                                  ResultPrecision /*precision*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_pass(const Scene * /*scene*/, int /*view_layer*/, const char * /*name*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  StringRef get_view_name() const override
+  {
+    return "";
+  }
+
+  ResultPrecision get_precision() const override
+  {
+    return ResultPrecision::Full;
+  }
+
+  void set_info_message(StringRef /*message*/) const override {}
+
+  IDRecalcFlag query_id_recalc_flag(ID * /*id*/) const override
+  {
+    return IDRecalcFlag(0);
+  }
+};
+
+}  // namespace blender::compositor::tests
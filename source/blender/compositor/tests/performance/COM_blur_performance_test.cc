@@ -0,0 +1,183 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_rect.h"
+#include "BLI_string_ref.hh"
+#include "BLI_timeit.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_result.hh"
+
+#include "COM_algorithm_recursive_gaussian_blur.hh"
+#include "COM_algorithm_symmetric_separable_blur.hh"
+
+namespace blender::compositor::tests {
+
+/* A minimal CPU context that only supports what is needed to evaluate the blur algorithms. */
+class BenchmarkContext : public Context {
+ private:
+  Scene scene_ = {};
+  bNodeTree node_tree_ = {};
+  RenderData render_data_ = {};
+
+ public:
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  const bNodeTree &get_node_tree() const override
+  {
+    return node_tree_;
+  }
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+
+  eCompositorDenoiseQaulity get_denoise_quality() const override
+  {
+    return SCE_COMPOSITOR_DENOISE_BALANCED;
+  }
+
+  OutputTypes needed_outputs() const override
+  {
+    return OutputTypes::None;
+  }
+
+  const RenderData &get_render_data() const override
+  {
+    return render_data_;
+  }
+
+  int2 get_render_size() const override
+  {
+    return int2(0);
+  }
+
+  rcti get_compositing_region() const override
+  {
+    return rcti{0, 0, 0, 0};
+  }
+
+  Result get_output_result() override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_viewer_output_result(Domain /*domain*/,
+                                  bool /*is_data*/,
+                                  ResultPrecision /*precision*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_pass(const Scene * /*scene*/, int /*view_layer*/, const char * /*name*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  StringRef get_view_name() const override
+  {
+    return "";
+  }
+
+  ResultPrecision get_precision() const override
+  {
+    return ResultPrecision::Full;
+  }
+
+  void set_info_message(StringRef /*message*/) const override {}
+
+  IDRecalcFlag query_id_recalc_flag(ID * /*id*/) const override
+  {
+    return IDRecalcFlag(0);
+  }
+};
+
+static Result create_input_image(Context &context, const ResultType type, const int2 size)
+{
+  Result image = context.create_result(type);
+  image.allocate_texture(Domain(size));
+  float *data = static_cast<float *>(image.cpu_data().data());
+  const int64_t values_count = int64_t(size.x) * size.y * image.channels_count();
+  for (int64_t i = 0; i < values_count; i++) {
+    data[i] = float(i % 251) / 250.0f;
+  }
+  return image;
+}
+
+static void blur_perf_impl(const ResultType type,
+                           const int2 size,
+                           const float radius,
+                           const bool use_recursive_blur)
+{
+  BenchmarkContext context;
+  Result input = create_input_image(context, type, size);
+  Result output = context.create_result(type);
+
+  /* Compute the cached blur weights or coefficients once such that they are not timed. */
+  if (use_recursive_blur) {
+    recursive_gaussian_blur(context, input, output, float2(radius));
+  }
+  else {
+    symmetric_separable_blur(context, input, output, float2(radius));
+  }
+  output.release();
+
+  const std::string name = std::string(use_recursive_blur ? "recursive" : "separable") + "_" +
+                           (type == ResultType::Float ? "float" : "color") + "_" +
+                           std::to_string(size.x) + "x" + std::to_string(size.y) + "_r" +
+                           std::to_string(int(radius));
+  {
+    SCOPED_TIMER(name.c_str());
+    for (int i = 0; i < 4; i++) {
+      output = context.create_result(type);
+      if (use_recursive_blur) {
+        recursive_gaussian_blur(context, input, output, float2(radius));
+      }
+      else {
+        symmetric_separable_blur(context, input, output, float2(radius));
+      }
+      output.release();
+    }
+  }
+
+  input.release();
+}
+
+static const int2 resolutions[] = {int2(1920, 1080), int2(3840, 2160)};
+
+TEST(compositor_blur, separable_blur_perf)
+{
+  for (const int2 size : resolutions) {
+    for (const float radius : {2.0f, 8.0f, 32.0f}) {
+      blur_perf_impl(ResultType::Float, size, radius, false);
+      blur_perf_impl(ResultType::Color, size, radius, false);
+    }
+  }
+}
+
+TEST(compositor_blur, recursive_blur_perf)
+{
+  /* The radii are chosen such that both the Deriche and Van Vliet filters are measured, see
+   * the recursive_gaussian_blur function for more information. */
+  for (const int2 size : resolutions) {
+    for (const float radius : {16.0f, 64.0f, 256.0f}) {
+      blur_perf_impl(ResultType::Color, size, radius, true);
+    }
+  }
+}
+
+}  // namespace blender::compositor::tests
@@ -200,6 +200,13 @@ void DEG_evaluate_on_refresh(
     Depsgraph *graph,
     DepsgraphEvaluateSyncWriteback sync_writeback = DEG_EVALUATE_SYNC_WRITEBACK_NO);
 
+/**
+ * Check whether evaluating a frame does not depend on the evaluation of previous frames.
+ * This is not the case when the graph contains point caches, rigid body simulation or geometry
+ * nodes simulation and bake nodes.
+ */
+bool DEG_graph_frames_are_independent(const Depsgraph *graph);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -8,8 +8,14 @@
  * Evaluation engine entry-points for Depsgraph Engine.
  */
 
+#include "BLI_listbase.h"
+
+#include "BKE_modifier.hh"
+#include "BKE_pointcache.h"
 #include "BKE_scene.hh"
 
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "DEG_depsgraph.hh"
@@ -20,6 +26,7 @@
 #include "intern/eval/deg_eval_flush.h"
 
 #include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_id.hh"
 #include "intern/node/deg_node_operation.hh"
 
 #include "intern/depsgraph.hh"
@@ -85,3 +92,42 @@ void DEG_evaluate_on_framechange(Depsgraph *graph,
   deg_graph->ctime = BKE_scene_frame_to_ctime(scene, frame);
   deg_flush_updates_and_refresh(deg_graph, sync_writeback);
 }
+
+static bool object_frames_are_independent(Scene *scene, Object *object)
+{
+  if (BKE_ptcache_object_has(scene, object, 0)) {
+    return false;
+  }
+  LISTBASE_FOREACH (const ModifierData *, md, &object->modifiers) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+    if (mti != nullptr && (mti->flags & eModifierTypeFlag_UsesPointCache)) {
+      return false;
+    }
+    if (md->type == eModifierType_Nodes) {
+      /* Simulation zones depend on the previous frame. Bake nodes are included as well, since
+       * they may be baked from a simulation. */
+      if (reinterpret_cast<const NodesModifierData *>(md)->bakes_num > 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool DEG_graph_frames_are_independent(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  Scene *scene = deg_graph->scene;
+  if (scene->rigidbody_world != nullptr) {
+    return false;
+  }
+  for (const deg::IDNode *id_node : deg_graph->id_nodes) {
+    if (GS(id_node->id_orig->name) != ID_OB) {
+      continue;
+    }
+    if (!object_frames_are_independent(scene, reinterpret_cast<Object *>(id_node->id_orig))) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -124,6 +124,7 @@ static int wm_alembic_export_exec(bContext *C, wmOperator *op)
   params.quad_method = RNA_enum_get(op->ptr, "quad_method");
   params.ngon_method = RNA_enum_get(op->ptr, "ngon_method");
   params.evaluation_mode = eEvaluationMode(RNA_enum_get(op->ptr, "evaluation_mode"));
+  params.parallel_frames = RNA_int_get(op->ptr, "parallel_frames");
 
   params.global_scale = RNA_float_get(op->ptr, "global_scale");
 
@@ -190,6 +191,7 @@ static void ui_alembic_export_settings(const bContext *C, uiLayout *layout, Poin
 
     col = uiLayoutColumn(panel, true);
     uiItemR(col, ptr, "evaluation_mode", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+    uiItemR(col, ptr, "parallel_frames", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   }
 
   /* Object Data */
@@ -469,6 +471,19 @@ void WM_OT_alembic_export(wmOperatorType *ot)
                "Determines visibility of objects, modifier settings, and other areas where there "
                "are different settings for viewport and rendering");
 
+  RNA_def_int(ot->srna,
+              "parallel_frames",
+              1,
+              1,
+              64,
+              "Parallel Frames",
+              "Number of frames to keep evaluated at the same time, each using its own copy of "
+              "the evaluated scene, so that upcoming frames are evaluated while a frame is "
+              "written. Only used when the scene has no simulation caches. Frame change "
+              "handlers are not run for frames evaluated ahead",
+              1,
+              16);
+
   /* This dummy prop is used to check whether we need to init the start and
    * end frame values to that of the scene's, otherwise they are reset at
    * every change, draw update. */
@@ -394,6 +394,7 @@ static int wm_usd_export_exec(bContext *C, wmOperator *op)
 
   params.export_subdiv = export_subdiv;
   params.evaluation_mode = eEvaluationMode(evaluation_mode);
+  params.parallel_frames = RNA_int_get(op->ptr, "parallel_frames");
 
   params.generate_preview_surface = generate_preview_surface;
   params.generate_materialx_network = generate_materialx_network;
@@ -473,6 +474,7 @@ static void wm_usd_export_draw(bContext *C, wmOperator *op)
 
     col = uiLayoutColumn(panel, false);
     uiItemR(col, ptr, "evaluation_mode", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+    uiItemR(col, ptr, "parallel_frames", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   }
 
   if (uiLayout *panel = uiLayoutPanel(
@@ -719,6 +721,20 @@ void WM_OT_usd_export(wmOperatorType *ot)
                "Determines visibility of objects, modifier settings, and other areas where there "
                "are different settings for viewport and rendering");
 
+  RNA_def_int(ot->srna,
+              "parallel_frames",
+              1,
+              1,
+              64,
+              "Parallel Frames",
+              "Number of animation frames to keep evaluated at the same time, each using its "
+              "own copy of the evaluated scene, so that upcoming frames are evaluated while a "
+              "frame is written. Only used when the scene has no simulation caches and no "
+              "armatures or shape keys are exported. Frame change handlers are not run for frames "
+              "evaluated ahead",
+              1,
+              16);
+
   RNA_def_boolean(ot->srna,
                   "generate_preview_surface",
                   true,
@@ -7,6 +7,7 @@
  * \ingroup spseq
  */
 
+#include <cinttypes>
 #include <cmath>
 #include <cstring>
 
@@ -1850,6 +1851,56 @@ static void draw_cache_view(const bContext *C)
   GPU_blend(GPU_BLEND_NONE);
 }
 
+/* Draw hits, misses and a histogram of read times of the disk cache, below the final cache
+ * stripe. Drawn in region space. */
+static void draw_disk_cache_statistics(const bContext *C, const ARegion *region)
+{
+  Scene *scene = CTX_data_scene(C);
+  const SpaceSeq *sseq = CTX_wm_space_seq(C);
+
+  if ((sseq->flag & SEQ_SHOW_OVERLAY) == 0 || (sseq->cache_overlay.flag & SEQ_CACHE_SHOW) == 0) {
+    return;
+  }
+
+  SeqDiskCacheStatistics statistics;
+  if (!SEQ_disk_cache_statistics_get(scene, &statistics)) {
+    return;
+  }
+  const int64_t reads_num = statistics.hits + statistics.misses;
+  if (reads_num == 0) {
+    return;
+  }
+
+  char hits_str[128];
+  SNPRINTF(hits_str,
+           "Disk Cache: %" PRId64 " hits, %" PRId64 " misses (%d%%)",
+           statistics.hits,
+           statistics.misses,
+           int(statistics.hits * 100 / reads_num));
+
+  char histogram_str[256];
+  size_t histogram_len = BLI_strncpy_rlen(histogram_str, "Read Time:", sizeof(histogram_str));
+  for (int i = 0; i < SEQ_DISK_CACHE_READ_TIME_BUCKETS; i++) {
+    const bool is_last = i == SEQ_DISK_CACHE_READ_TIME_BUCKETS - 1;
+    histogram_len += BLI_snprintf_rlen(histogram_str + histogram_len,
+                                       sizeof(histogram_str) - histogram_len,
+                                       "  %s%d ms: %" PRId64,
+                                       is_last ? ">=" : "<",
+                                       is_last ? 1 << (i - 1) : 1 << i,
+                                       statistics.read_time_histogram[i]);
+  }
+
+  const int font_id = BLF_set_default();
+  UI_FontThemeColor(font_id, TH_TEXT_HI);
+  const float line_height = BLF_height_max(font_id) * 1.5f;
+  const float x = 0.5f * U.widget_unit;
+  float y = region->winy - UI_TIME_SCRUB_MARGIN_Y - UI_TIME_CACHE_MARGIN_Y - line_height;
+
+  BLF_draw_default(x, y, 0.0f, hits_str, sizeof(hits_str));
+  y -= line_height;
+  BLF_draw_default(x, y, 0.0f, histogram_str, sizeof(histogram_str));
+}
+
 /* Draw sequencer timeline. */
 static void draw_overlap_frame_indicator(const Scene *scene, const View2D *v2d)
 {
@@ -1977,6 +2028,7 @@ void draw_timeline_seq_display(const bContext *C, ARegion *region)
       draw_overlap_frame_indicator(scene, v2d);
     }
     UI_view2d_view_restore(C);
+    draw_disk_cache_statistics(C, region);
   }
 
   ED_time_scrub_draw_current_frame(region, scene, !(sseq->flag & SEQ_DRAWFRAMES));
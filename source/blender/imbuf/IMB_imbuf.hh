@@ -330,6 +330,11 @@ enum class IMBScaleFilter {
    * better results when scaling down by more than 2x.
    */
   Box,
+  /**
+   * Separable Lanczos filter with a support of 3 pixels, widened to the source footprint when
+   * scaling down. Sharpest results in both directions, at a higher cost than Box.
+   */
+  Lanczos,
 };
 
 /**
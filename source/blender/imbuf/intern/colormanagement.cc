@@ -9,6 +9,7 @@
 #include "IMB_colormanagement.hh"
 #include "IMB_colormanagement_intern.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -96,10 +97,55 @@ float imbuf_aces_to_scene_linear[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Transforms of a processor that are evaluated without going through OCIO. */
+enum class SRGBFastPath : int8_t {
+  None,
+  /* Byte input is converted from sRGB to scene linear through the BLI lookup table. */
+  ToLinearFromByte,
+  /* Scene linear is converted to sRGB with the vectorized BLI functions, negative values are
+   * clamped to zero or mirrored, matching what the OCIO processor does. */
+  FromLinearClamp,
+  FromLinearMirror,
+};
+
+struct DisplayProcessorCacheEntry {
+  char look[MAX_COLORSPACE_NAME];
+  char view_transform[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  float exposure;
+  float gamma;
+  float temperature;
+  float tint;
+  bool use_white_balance;
+
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor;
+  SRGBFastPath fast_path;
+
+  /* Number of processors using the entry, which is only freed once it is evicted from the cache
+   * and has no users left. Both are protected by the processor_lock. */
+  int users;
+  bool is_evicted;
+};
+
+/* Display processors are expensive to create, especially for views that bake LUTs like Filmic
+ * and AgX, and the same few view settings are used over and over again. So keep the most recently
+ * used ones around, ordered from the most to the least recently used. */
+#define DISPLAY_PROCESSOR_CACHE_SIZE 4
+static DisplayProcessorCacheEntry *display_processor_cache[DISPLAY_PROCESSOR_CACHE_SIZE] = {
+    nullptr};
+/* Incremented every time the cache is freed because the configuration is freed or reloaded, such
+ * that processors created from the previous configuration are not inserted. Protected by the
+ * processor_lock. */
+static int display_processor_cache_generation = 0;
+
 struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* The CPU processor is owned by a color space or by the display processor cache entry. */
+  bool is_cpu_processor_shared;
+  DisplayProcessorCacheEntry *display_cache_entry;
+  SRGBFastPath fast_path;
 };
 
 static struct global_gpu_state {
@@ -608,11 +654,15 @@ static bool colormanage_load_config(OCIO_ConstConfigRcPtr *config)
   return ok;
 }
 
+static void display_processor_cache_free();
+
 static void colormanage_free_config()
 {
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  display_processor_cache_free();
+
   /* free color spaces */
   colorspace = static_cast<ColorSpace *>(global_colorspaces.first);
   while (colorspace) {
@@ -923,6 +973,250 @@ static OCIO_ConstCPUProcessorRcPtr *create_display_buffer_processor(const char *
   return cpu_processor;
 }
 
+static bool srgb_fast_path_compare(const float a, const float b)
+{
+  return fabsf(a - b) <= 1e-4f * max_ff(1.0f, fabsf(b));
+}
+
+/* The alpha that the color of the pixel is divided by before the conversion and multiplied by
+ * after it, matching OCIO_cpuProcessorApply_predivide. */
+static float srgb_fast_path_alpha(const float *pixel, const int channels, const bool predivide)
+{
+  if (channels == 4 && predivide && !ELEM(pixel[3], 0.0f, 1.0f)) {
+    return pixel[3];
+  }
+  return 1.0f;
+}
+
+/* Convert the colors of the given pixels from linear to sRGB. The colors are gathered into a
+ * contiguous array for a chunk of pixels at a time, such that the conversion is vectorized across
+ * the color channels of consecutive pixels. */
+static void srgb_fast_path_apply(const SRGBFastPath fast_path,
+                                 float *buffer,
+                                 const int64_t pixels_num,
+                                 const int channels,
+                                 const bool predivide)
+{
+  constexpr int64_t chunk_size = 256;
+  float colors[chunk_size * 3];
+  const bool mirror = fast_path == SRGBFastPath::FromLinearMirror;
+
+  for (int64_t chunk_start = 0; chunk_start < pixels_num; chunk_start += chunk_size) {
+    const int64_t chunk_pixels_num = std::min(chunk_size, pixels_num - chunk_start);
+    float *chunk = buffer + chunk_start * channels;
+
+    for (int64_t i = 0; i < chunk_pixels_num; i++) {
+      const float *pixel = chunk + i * channels;
+      const float alpha = srgb_fast_path_alpha(pixel, channels, predivide);
+      for (int c = 0; c < 3; c++) {
+        const float color = pixel[c] / alpha;
+        colors[i * 3 + c] = mirror ? fabsf(color) : color;
+      }
+    }
+
+    linearrgb_to_srgb_array(colors, int(chunk_pixels_num * 3));
+
+    for (int64_t i = 0; i < chunk_pixels_num; i++) {
+      float *pixel = chunk + i * channels;
+      const float alpha = srgb_fast_path_alpha(pixel, channels, predivide);
+      for (int c = 0; c < 3; c++) {
+        const bool is_negative = mirror && pixel[c] / alpha < 0.0f;
+        pixel[c] = (is_negative ? -colors[i * 3 + c] : colors[i * 3 + c]) * alpha;
+      }
+    }
+  }
+}
+
+/* Check whether the CPU processor applies the inverse sRGB EOTF to each channel independently,
+ * as is the case for the Standard view on an sRGB display with Rec.709 scene linear primaries,
+ * and return how it can be replaced by the vectorized BLI conversion. The processor is compared
+ * to the fast path itself, so the error of the approximate power function is accounted for. */
+static SRGBFastPath cpu_processor_linear_to_srgb_fast_path(
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  if (cpu_processor == nullptr) {
+    return SRGBFastPath::None;
+  }
+
+  /* Vary one channel at a time while keeping the others fixed, so that channel crosstalk like in
+   * a matrix transform is detected. */
+  const float samples[] = {0.0f, 0.001f, 0.0031308f, 0.01f, 0.18f, 0.5f, 1.0f, 4.0f, 16.0f};
+  const float fixed[3] = {0.25f, 0.75f, 0.05f};
+  for (const float sample : samples) {
+    for (int channel = 0; channel < 3; channel++) {
+      float pixel[3];
+      copy_v3_v3(pixel, fixed);
+      pixel[channel] = sample;
+      float expected[3];
+      copy_v3_v3(expected, pixel);
+      OCIO_cpuProcessorApplyRGB(cpu_processor, pixel);
+      srgb_fast_path_apply(SRGBFastPath::FromLinearClamp, expected, 1, 3, false);
+      for (int i = 0; i < 3; i++) {
+        if (!srgb_fast_path_compare(pixel[i], expected[i])) {
+          return SRGBFastPath::None;
+        }
+      }
+    }
+  }
+
+  float negative[3] = {-0.1f, -0.1f, -0.1f};
+  float clamped[3], mirrored[3];
+  copy_v3_v3(clamped, negative);
+  copy_v3_v3(mirrored, negative);
+  OCIO_cpuProcessorApplyRGB(cpu_processor, negative);
+  srgb_fast_path_apply(SRGBFastPath::FromLinearClamp, clamped, 1, 3, false);
+  srgb_fast_path_apply(SRGBFastPath::FromLinearMirror, mirrored, 1, 3, false);
+  if (srgb_fast_path_compare(negative[0], clamped[0])) {
+    return SRGBFastPath::FromLinearClamp;
+  }
+  if (srgb_fast_path_compare(negative[0], mirrored[0])) {
+    return SRGBFastPath::FromLinearMirror;
+  }
+  return SRGBFastPath::None;
+}
+
+static void display_processor_cache_entry_free(DisplayProcessorCacheEntry *entry)
+{
+  if (entry->cpu_processor) {
+    OCIO_cpuProcessorRelease(entry->cpu_processor);
+  }
+  MEM_freeN(entry);
+}
+
+static bool display_processor_cache_entry_matches(
+    const DisplayProcessorCacheEntry *entry,
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  const bool use_white_balance = view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE;
+  return STREQ(entry->look, view_settings->look) &&
+         STREQ(entry->view_transform, view_settings->view_transform) &&
+         STREQ(entry->display, display_settings->display_device) &&
+         entry->exposure == view_settings->exposure && entry->gamma == view_settings->gamma &&
+         entry->use_white_balance == use_white_balance &&
+         (!use_white_balance || (entry->temperature == view_settings->temperature &&
+                                 entry->tint == view_settings->tint));
+}
+
+/* Find the cached entry matching the given settings, move it to the front of the cache and add a
+ * user to it. Expects the processor_lock to be held. */
+static DisplayProcessorCacheEntry *display_processor_cache_lookup(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  for (int i = 0; i < DISPLAY_PROCESSOR_CACHE_SIZE; i++) {
+    DisplayProcessorCacheEntry *entry = display_processor_cache[i];
+    if (entry && display_processor_cache_entry_matches(entry, view_settings, display_settings)) {
+      memmove(display_processor_cache + 1, display_processor_cache, sizeof(entry) * i);
+      display_processor_cache[0] = entry;
+      entry->users++;
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+/* Get the cached display processor for the given settings, creating it if needed. The entry must
+ * be released with #display_processor_cache_release once it is not used anymore. */
+static DisplayProcessorCacheEntry *display_processor_cache_acquire(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  BLI_mutex_lock(&processor_lock);
+  DisplayProcessorCacheEntry *cached_entry = display_processor_cache_lookup(view_settings,
+                                                                            display_settings);
+  const int generation = display_processor_cache_generation;
+  BLI_mutex_unlock(&processor_lock);
+  if (cached_entry) {
+    return cached_entry;
+  }
+
+  /* Create the processor without holding the lock, since it can take a while. */
+  DisplayProcessorCacheEntry *entry = MEM_cnew<DisplayProcessorCacheEntry>(__func__);
+  STRNCPY(entry->look, view_settings->look);
+  STRNCPY(entry->view_transform, view_settings->view_transform);
+  STRNCPY(entry->display, display_settings->display_device);
+  entry->exposure = view_settings->exposure;
+  entry->gamma = view_settings->gamma;
+  entry->temperature = view_settings->temperature;
+  entry->tint = view_settings->tint;
+  entry->use_white_balance = view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE;
+  entry->cpu_processor = create_display_buffer_processor(entry->look,
+                                                         entry->view_transform,
+                                                         entry->display,
+                                                         entry->exposure,
+                                                         entry->gamma,
+                                                         entry->temperature,
+                                                         entry->tint,
+                                                         entry->use_white_balance,
+                                                         global_role_scene_linear);
+  entry->fast_path = cpu_processor_linear_to_srgb_fast_path(entry->cpu_processor);
+  entry->users = 1;
+
+  BLI_mutex_lock(&processor_lock);
+  /* The configuration was freed or reloaded while creating the processor, so it might be created
+   * from outdated color spaces. Don't cache it, it is freed once released. */
+  if (generation != display_processor_cache_generation) {
+    entry->is_evicted = true;
+    BLI_mutex_unlock(&processor_lock);
+    return entry;
+  }
+
+  /* Another thread might have cached a processor for the same settings in the meantime. */
+  cached_entry = display_processor_cache_lookup(view_settings, display_settings);
+  if (cached_entry) {
+    BLI_mutex_unlock(&processor_lock);
+    display_processor_cache_entry_free(entry);
+    return cached_entry;
+  }
+
+  DisplayProcessorCacheEntry *evicted_entry =
+      display_processor_cache[DISPLAY_PROCESSOR_CACHE_SIZE - 1];
+  if (evicted_entry) {
+    evicted_entry->is_evicted = true;
+    if (evicted_entry->users == 0) {
+      display_processor_cache_entry_free(evicted_entry);
+    }
+  }
+  memmove(display_processor_cache + 1,
+          display_processor_cache,
+          sizeof(entry) * (DISPLAY_PROCESSOR_CACHE_SIZE - 1));
+  display_processor_cache[0] = entry;
+  BLI_mutex_unlock(&processor_lock);
+
+  return entry;
+}
+
+static void display_processor_cache_release(DisplayProcessorCacheEntry *entry)
+{
+  BLI_mutex_lock(&processor_lock);
+  entry->users--;
+  const bool do_free = entry->is_evicted && entry->users == 0;
+  BLI_mutex_unlock(&processor_lock);
+
+  if (do_free) {
+    display_processor_cache_entry_free(entry);
+  }
+}
+
+/* Evict all entries, entries still in use are freed once released. */
+static void display_processor_cache_free()
+{
+  BLI_mutex_lock(&processor_lock);
+  display_processor_cache_generation++;
+  for (int i = 0; i < DISPLAY_PROCESSOR_CACHE_SIZE; i++) {
+    DisplayProcessorCacheEntry *entry = display_processor_cache[i];
+    if (entry) {
+      entry->is_evicted = true;
+      if (entry->users == 0) {
+        display_processor_cache_entry_free(entry);
+      }
+      display_processor_cache[i] = nullptr;
+    }
+  }
+  BLI_mutex_unlock(&processor_lock);
+}
+
 static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const char *from_colorspace,
                                                                        const char *to_colorspace)
 {
@@ -1564,6 +1858,7 @@ struct DisplayBufferThread {
 
   const char *byte_colorspace;
   const char *float_colorspace;
+  bool byte_colorspace_is_srgb;
 };
 
 struct DisplayBufferInitData {
@@ -1579,6 +1874,7 @@ struct DisplayBufferInitData {
 
   const char *byte_colorspace;
   const char *float_colorspace;
+  bool byte_colorspace_is_srgb;
 };
 
 static void display_buffer_init_handle(DisplayBufferThread *handle,
@@ -1627,6 +1923,7 @@ static void display_buffer_init_handle(DisplayBufferThread *handle,
 
   handle->byte_colorspace = init_data->byte_colorspace;
   handle->float_colorspace = init_data->float_colorspace;
+  handle->byte_colorspace_is_srgb = init_data->byte_colorspace_is_srgb;
 }
 
 static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
@@ -1654,6 +1951,28 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
     const size_t i_last = size_t(width) * height;
     size_t i;
 
+    if (!is_data && !is_data_display && handle->byte_colorspace_is_srgb) {
+      /* Convert sRGB bytes straight to scene linear through the lookup table. */
+      for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
+           i++, fp += channels, cp += channels)
+      {
+        if (channels == 3) {
+          fp[0] = BLI_color_from_srgb_table[cp[0]];
+          fp[1] = BLI_color_from_srgb_table[cp[1]];
+          fp[2] = BLI_color_from_srgb_table[cp[2]];
+        }
+        else if (channels == 4) {
+          srgb_to_linearrgb_uchar4(fp, cp);
+        }
+        else {
+          BLI_assert_msg(0, "Buffers of 3 or 4 channels are only supported here");
+        }
+      }
+
+      *is_straight_alpha = true;
+      return;
+    }
+
     /* first convert byte buffer to float, keep in image space */
     for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
          i++, fp += channels, cp += channels)
@@ -1855,6 +2174,8 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
      */
     init_data.byte_colorspace = global_role_default_byte;
   }
+  init_data.byte_colorspace_is_srgb = IMB_colormanagement_space_name_is_srgb(
+      init_data.byte_colorspace);
 
   if (ibuf->float_buffer.colorspace != nullptr) {
     /* sequencer stores float buffers in non-linear space */
@@ -2015,7 +2336,18 @@ static void do_processor_transform_thread(ProcessorTransformThread *handle)
   const bool predivide = handle->predivide;
   const bool float_from_byte = handle->float_from_byte;
 
-  if (float_from_byte) {
+  if (float_from_byte && handle->cm_processor->fast_path == SRGBFastPath::ToLinearFromByte &&
+      handle->cm_processor->curve_mapping == nullptr && channels == 4)
+  {
+    /* Convert sRGB bytes to premultiplied scene linear through the lookup table. */
+    const int64_t pixels_num = int64_t(width) * height;
+    for (int64_t i = 0; i < pixels_num; i++) {
+      float *pixel = float_buffer + i * 4;
+      srgb_to_linearrgb_uchar4(pixel, byte_buffer + i * 4);
+      straight_to_premul_v4(pixel);
+    }
+  }
+  else if (float_from_byte) {
     IMB_buffer_float_from_byte(float_buffer,
                                byte_buffer,
                                IB_PROFILE_SRGB,
@@ -3898,17 +4230,12 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  const bool use_white_balance = applied_view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE;
-  cm_processor->cpu_processor = create_display_buffer_processor(
-      applied_view_settings->look,
-      applied_view_settings->view_transform,
-      display_settings->display_device,
-      applied_view_settings->exposure,
-      applied_view_settings->gamma,
-      applied_view_settings->temperature,
-      applied_view_settings->tint,
-      use_white_balance,
-      global_role_scene_linear);
+  DisplayProcessorCacheEntry *entry = display_processor_cache_acquire(applied_view_settings,
+                                                                      display_settings);
+  cm_processor->cpu_processor = entry->cpu_processor;
+  cm_processor->is_cpu_processor_shared = true;
+  cm_processor->display_cache_entry = entry;
+  cm_processor->fast_path = entry->fast_path;
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -3926,6 +4253,30 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
   cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
   cm_processor->is_data_result = IMB_colormanagement_space_name_is_data(to_colorspace);
 
+  /* Transforms from and to scene linear are by far the most common ones, reuse the processors
+   * cached in the color spaces for them. */
+  ColorSpace *from_space = colormanage_colorspace_get_named(from_colorspace);
+  ColorSpace *to_space = colormanage_colorspace_get_named(to_colorspace);
+  if (from_space && to_space && !from_space->is_data && !to_space->is_data) {
+    if (IMB_colormanagement_space_is_scene_linear(to_space)) {
+      cm_processor->cpu_processor = colorspace_to_scene_linear_cpu_processor(from_space);
+      cm_processor->is_cpu_processor_shared = true;
+      if (IMB_colormanagement_space_is_srgb(from_space)) {
+        cm_processor->fast_path = SRGBFastPath::ToLinearFromByte;
+      }
+      return cm_processor;
+    }
+    if (IMB_colormanagement_space_is_scene_linear(from_space)) {
+      cm_processor->cpu_processor = colorspace_from_scene_linear_cpu_processor(to_space);
+      cm_processor->is_cpu_processor_shared = true;
+      if (IMB_colormanagement_space_is_srgb(to_space)) {
+        cm_processor->fast_path = cpu_processor_linear_to_srgb_fast_path(
+            cm_processor->cpu_processor);
+      }
+      return cm_processor;
+    }
+  }
+
   OCIO_ConstProcessorRcPtr *processor = create_colorspace_transform_processor(from_colorspace,
                                                                               to_colorspace);
   if (processor != nullptr) {
@@ -3961,13 +4312,23 @@ bool IMB_colormanagement_processor_is_noop(ColormanageProcessor *cm_processor)
   return OCIO_cpuProcessorIsNoOp(cm_processor->cpu_processor);
 }
 
+/* Whether the OCIO processor can be replaced by the vectorized conversion to sRGB. */
+static bool processor_use_srgb_fast_path(const ColormanageProcessor *cm_processor)
+{
+  return ELEM(
+      cm_processor->fast_path, SRGBFastPath::FromLinearClamp, SRGBFastPath::FromLinearMirror);
+}
+
 void IMB_colormanagement_processor_apply_v4(ColormanageProcessor *cm_processor, float pixel[4])
 {
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (processor_use_srgb_fast_path(cm_processor)) {
+    srgb_fast_path_apply(cm_processor->fast_path, pixel, 1, 4, false);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGBA(cm_processor->cpu_processor, pixel);
   }
 }
@@ -3979,7 +4340,10 @@ void IMB_colormanagement_processor_apply_v4_predivide(ColormanageProcessor *cm_p
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (processor_use_srgb_fast_path(cm_processor)) {
+    srgb_fast_path_apply(cm_processor->fast_path, pixel, 1, 4, true);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGBA_predivide(cm_processor->cpu_processor, pixel);
   }
 }
@@ -3990,7 +4354,10 @@ void IMB_colormanagement_processor_apply_v3(ColormanageProcessor *cm_processor,
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (processor_use_srgb_fast_path(cm_processor)) {
+    srgb_fast_path_apply(cm_processor->fast_path, pixel, 1, 3, false);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGB(cm_processor->cpu_processor, pixel);
   }
 }
@@ -4036,7 +4403,11 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
     }
   }
 
-  if (cm_processor->cpu_processor && channels >= 3) {
+  if (processor_use_srgb_fast_path(cm_processor) && channels >= 3) {
+    srgb_fast_path_apply(
+        cm_processor->fast_path, buffer, int64_t(width) * height, channels, predivide);
+  }
+  else if (cm_processor->cpu_processor && channels >= 3) {
     OCIO_PackedImageDesc *img;
 
     /* apply OCIO processor */
@@ -4082,7 +4453,10 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->display_cache_entry) {
+    display_processor_cache_release(cm_processor->display_cache_entry);
+  }
+  else if (cm_processor->cpu_processor && !cm_processor->is_cpu_processor_shared) {
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
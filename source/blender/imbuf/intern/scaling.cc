@@ -7,9 +7,12 @@
  * \ingroup imbuf
  */
 
+#include "BLI_array.hh"
+#include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 #include "MEM_guardedalloc.h"
 
 #include "IMB_filter.hh"
@@ -442,7 +445,22 @@ struct ScaleDownX {
   }
 };
 
+/* The vertical box filters are computed on whole destination rows, in parallel, rather than
+ * column by column, such that memory is accessed contiguously. The filter position only depends on
+ * the row, so it is precomputed for all rows, step by step exactly like a sequential column walk
+ * would, which keeps the results identical to it. */
 struct ScaleDownY {
+  /* The source rows contributing to a destination row: the row before #first_row weighted by
+   * #sample_start, subtracted since it was already accounted for by the previous destination row,
+   * the #rows_num full rows starting at #first_row, and the row after them weighted by
+   * #sample_end. */
+  struct RowSamples {
+    float sample_start;
+    float sample_end;
+    int first_row;
+    int rows_num;
+  };
+
   template<typename T>
   static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy, bool threaded)
   {
@@ -450,31 +468,40 @@ struct ScaleDownY {
     const float add = (ibufy - 0.01f) / newy;
     const float inv_add = 1.0f / add;
 
-    const int grain_size = threaded ? 32 : ibufx;
-    threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
-      for (const int x : range) {
-        const T *src_ptr = src + x;
-        T *dst_ptr = dst + x;
-        float sample = 0.0f;
-        float4 val(0.0f);
+    Array<RowSamples> row_samples(newy);
+    float sample = 0.0f;
+    int src_row = 0;
+    for (const int y : IndexRange(newy)) {
+      RowSamples &samples = row_samples[y];
+      samples.sample_start = sample;
+      samples.first_row = src_row;
+      sample += add;
+      while (sample >= 1.0f) {
+        sample -= 1.0f;
+        src_row++;
+      }
+      samples.rows_num = src_row - samples.first_row;
+      samples.sample_end = sample;
+      src_row++;
+      sample -= 1.0f;
+    }
 
-        for (int y = 0; y < newy; y++) {
-          float4 nval = -val * sample;
-          sample += add;
-          while (sample >= 1.0f) {
-            sample -= 1.0f;
-            nval += load_pixel(src_ptr);
-            src_ptr += ibufx;
+    const int grain_size = threaded ? 32 : newy;
+    threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange range) {
+      for (const int y : range) {
+        const RowSamples &samples = row_samples[y];
+        const T *src_ptr = src + int64_t(samples.first_row) * ibufx;
+        T *dst_ptr = dst + int64_t(y) * ibufx;
+        for (const int x : IndexRange(ibufx)) {
+          const float4 val = y == 0 ? float4(0.0f) : load_pixel(src_ptr - ibufx + x);
+          float4 nval = -val * samples.sample_start;
+          for (const int i : IndexRange(samples.rows_num)) {
+            nval += load_pixel(src_ptr + int64_t(i) * ibufx + x);
           }
+          const float4 end_val = load_pixel(src_ptr + int64_t(samples.rows_num) * ibufx + x);
 
-          val = load_pixel(src_ptr);
-          src_ptr += ibufx;
-
-          float4 pix = (nval + sample * val) * inv_add;
-          store_pixel(pix, dst_ptr);
-          dst_ptr += ibufx;
-
-          sample -= 1.0f;
+          float4 pix = (nval + samples.sample_end * end_val) * inv_add;
+          store_pixel(pix, dst_ptr + x);
         }
       }
     });
@@ -535,6 +562,13 @@ struct ScaleUpX {
 };
 
 struct ScaleUpY {
+  /* A destination row interpolates between two source rows. */
+  struct RowSamples {
+    float sample;
+    int row;
+    int next_row;
+  };
+
   template<typename T>
   static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy, bool threaded)
   {
@@ -546,43 +580,49 @@ struct ScaleUpY {
         memcpy(dst, src, sizeof(T) * ibufx);
         dst += ibufx;
       }
+      return;
     }
-    else {
-      const int grain_size = threaded ? 32 : ibufx;
-      threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
-        for (const int x : range) {
-          float sample = -0.5f + add * 0.5f;
-          int counter = 0;
-          const T *src_ptr = src + x;
-          T *dst_ptr = dst + x;
-
-          float4 val = load_pixel(src_ptr);
-          float4 nval = load_pixel(src_ptr + ibufx);
-          float4 diff = nval - val;
-          if (ibufy > 2) {
-            src_ptr += ibufx * 2;
-            counter += 2;
-          }
 
-          for (int y = 0; y < newy; y++) {
-            if (sample >= 1.0f) {
-              sample -= 1.0f;
-              val = nval;
-              nval = load_pixel(src_ptr);
-              diff = nval - val;
-              if (counter + 1 < ibufy) {
-                src_ptr += ibufx;
-                ++counter;
-              }
-            }
-            float4 pix = val + blender::math::max(sample, 0.0f) * diff;
-            store_pixel(pix, dst_ptr);
-            dst_ptr += ibufx;
-            sample += add;
-          }
+    Array<RowSamples> row_samples(newy);
+    float sample = -0.5f + add * 0.5f;
+    int counter = 0;
+    int row = 0;
+    int next_row = 1;
+    int src_row = 0;
+    if (ibufy > 2) {
+      src_row += 2;
+      counter += 2;
+    }
+    for (const int y : IndexRange(newy)) {
+      if (sample >= 1.0f) {
+        sample -= 1.0f;
+        row = next_row;
+        next_row = src_row;
+        if (counter + 1 < ibufy) {
+          src_row++;
+          counter++;
         }
-      });
+      }
+      row_samples[y] = {sample, row, next_row};
+      sample += add;
     }
+
+    const int grain_size = threaded ? 32 : newy;
+    threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange range) {
+      for (const int y : range) {
+        const RowSamples &samples = row_samples[y];
+        const T *src_ptr = src + int64_t(samples.row) * ibufx;
+        const T *next_src_ptr = src + int64_t(samples.next_row) * ibufx;
+        const float factor = math::max(samples.sample, 0.0f);
+        T *dst_ptr = dst + int64_t(y) * ibufx;
+        for (const int x : IndexRange(ibufx)) {
+          const float4 val = load_pixel(src_ptr + x);
+          const float4 diff = load_pixel(next_src_ptr + x) - val;
+          float4 pix = val + factor * diff;
+          store_pixel(pix, dst_ptr + x);
+        }
+      }
+    });
   }
 };
 
@@ -752,29 +792,176 @@ static void scale_bilinear_func(
   using namespace blender;
   using namespace blender::imbuf;
 
+  /* The horizontal sample positions are the same for all rows. */
+  const float factor_x = float(ibuf->x) / newx;
+  const float factor_y = float(ibuf->y) / newy;
+  Array<float> u_coords(newx);
+  for (const int x : IndexRange(newx)) {
+    u_coords[x] = (float(x) + 0.5f) * factor_x - 0.5f;
+  }
+
   const int grain_size = threaded ? 32 : newy;
   threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange y_range) {
-    float factor_x = float(ibuf->x) / newx;
-    float factor_y = float(ibuf->y) / newy;
-
     for (const int y : y_range) {
-      float v = (float(y) + 0.5f) * factor_y - 0.5f;
-      for (int x = 0; x < newx; x++) {
-        float u = (float(x) + 0.5f) * factor_x - 0.5f;
-        int64_t offset = int64_t(y) * newx + x;
-        if (dst_byte) {
-          interpolate_bilinear_byte(ibuf, (uchar *)(dst_byte + offset), u, v);
+      const float v = (float(y) + 0.5f) * factor_y - 0.5f;
+      const int64_t row_offset = int64_t(y) * newx;
+      if (dst_byte) {
+        uchar4 *dst_row = dst_byte + row_offset;
+        for (const int x : IndexRange(newx)) {
+          interpolate_bilinear_byte(ibuf, (uchar *)(dst_row + x), u_coords[x], v);
         }
-        if (dst_float) {
-          float *pixel = dst_float + ibuf->channels * offset;
-          math::interpolate_bilinear_fl(
-              ibuf->float_buffer.data, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
+      }
+      if (dst_float) {
+        float *dst_row = dst_float + ibuf->channels * row_offset;
+        for (const int x : IndexRange(newx)) {
+          math::interpolate_bilinear_fl(ibuf->float_buffer.data,
+                                        dst_row + ibuf->channels * x,
+                                        ibuf->x,
+                                        ibuf->y,
+                                        ibuf->channels,
+                                        u_coords[x],
+                                        v);
         }
       }
     }
   });
 }
 
+/* Lanczos filter kernel with a support of 3 pixels. */
+static float lanczos3(float x)
+{
+  constexpr float a = 3.0f;
+  x = blender::math::abs(x);
+  if (x < 1e-6f) {
+    return 1.0f;
+  }
+  if (x >= a) {
+    return 0.0f;
+  }
+  const float pi_x = float(blender::math::numbers::pi) * x;
+  return a * blender::math::sin(pi_x) * blender::math::sin(pi_x / a) / (pi_x * pi_x);
+}
+
+/**
+ * Precomputed filter weights for one axis of a separable resampling pass: every destination
+ * pixel reads #taps consecutive source pixels starting at its #starts entry. The window is
+ * shifted inside the source near the edges, with the weights of clamped samples folded onto the
+ * edge pixels, so that the inner loops need no bounds checks.
+ */
+struct ScaleWeights {
+  int taps = 0;
+  blender::Array<int> starts;
+  blender::Array<float> weights;
+
+  ScaleWeights(int src_size, int dst_size)
+  {
+    using namespace blender;
+    const float scale = float(src_size) / dst_size;
+    /* When scaling down the filter is widened to cover all source pixels of the footprint. */
+    const float filter_scale = math::max(scale, 1.0f);
+    const float support = 3.0f * filter_scale;
+    const int window = int(math::ceil(support * 2.0f)) + 1;
+    this->taps = math::min(window, src_size);
+    this->starts.reinitialize(dst_size);
+    this->weights.reinitialize(int64_t(dst_size) * this->taps);
+    this->weights.fill(0.0f);
+
+    for (const int i : IndexRange(dst_size)) {
+      const float center = (i + 0.5f) * scale;
+      const int left = int(math::floor(center - support));
+      const int start = math::clamp(left, 0, src_size - this->taps);
+      float *w = &this->weights[int64_t(i) * this->taps];
+      float sum = 0.0f;
+      for (const int j : IndexRange(window)) {
+        const int src = left + j;
+        const float weight = lanczos3((src + 0.5f - center) / filter_scale);
+        w[math::clamp(src, 0, src_size - 1) - start] += weight;
+        sum += weight;
+      }
+      if (sum != 0.0f) {
+        for (const int j : IndexRange(this->taps)) {
+          w[j] /= sum;
+        }
+      }
+      this->starts[i] = start;
+    }
+  }
+};
+
+struct ScaleLanczos {
+  template<typename T>
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int newy, bool threaded)
+  {
+    using namespace blender;
+    const ScaleWeights weights_x(ibufx, newx);
+    const ScaleWeights weights_y(ibufy, newy);
+
+    /* Destination rows are processed in tiles. Each tile filters the source rows it needs
+     * horizontally into a local buffer, then blends rows of that buffer vertically. Both passes
+     * are straight multiply-add loops over precomputed weights that the compiler vectorizes, and
+     * the intermediate buffer stays small enough to remain in cache. */
+    constexpr int tile_size = 64;
+    const int tiles_num = (newy + tile_size - 1) / tile_size;
+    const int grain_size = threaded ? 1 : tiles_num;
+    threading::parallel_for(IndexRange(tiles_num), grain_size, [&](IndexRange tile_range) {
+      Vector<float4> rows;
+      Array<float4> accum(newx);
+      for (const int tile : tile_range) {
+        const IndexRange dst_rows = IndexRange(newy).slice(
+            tile * tile_size, math::min(tile_size, newy - tile * tile_size));
+        const int src_first = weights_y.starts[dst_rows.first()];
+        const int src_last = weights_y.starts[dst_rows.last()] + weights_y.taps - 1;
+        rows.resize(int64_t(src_last - src_first + 1) * newx);
+
+        /* Horizontal pass. */
+        for (const int y : IndexRange(src_first, src_last - src_first + 1)) {
+          const T *src_row = src + int64_t(y) * ibufx;
+          float4 *row = &rows[int64_t(y - src_first) * newx];
+          for (const int x : IndexRange(newx)) {
+            const T *src_ptr = src_row + weights_x.starts[x];
+            const float *w = &weights_x.weights[int64_t(x) * weights_x.taps];
+            float4 pix(0.0f);
+            for (const int j : IndexRange(weights_x.taps)) {
+              pix += load_pixel(src_ptr + j) * w[j];
+            }
+            row[x] = pix;
+          }
+        }
+
+        /* Vertical pass. */
+        for (const int y : dst_rows) {
+          const int start = weights_y.starts[y] - src_first;
+          const float *w = &weights_y.weights[int64_t(y) * weights_y.taps];
+          accum.fill(float4(0.0f));
+          for (const int j : IndexRange(weights_y.taps)) {
+            const float4 *row = &rows[int64_t(start + j) * newx];
+            const float weight = w[j];
+            for (const int x : IndexRange(newx)) {
+              accum[x] += row[x] * weight;
+            }
+          }
+          T *dst_row = dst + int64_t(y) * newx;
+          for (const int x : IndexRange(newx)) {
+            float4 pix = accum[x];
+            if constexpr (std::is_same_v<T, uchar4>) {
+              /* Lanczos overshoots around sharp edges. */
+              pix = math::clamp(pix, 0.0f, 255.0f);
+            }
+            store_pixel(pix, dst_row + x);
+          }
+        }
+      }
+    });
+  }
+};
+
+static void scale_lanczos_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+{
+  ScaleLanczos op;
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+}
+
 bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool threaded)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
@@ -795,6 +982,9 @@ bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool th
     case IMBScaleFilter::Box:
       imb_scale_box(ibuf, newx, newy, threaded);
       break;
+    case IMBScaleFilter::Lanczos:
+      scale_with_function(ibuf, newx, newy, scale_lanczos_func, threaded);
+      break;
   }
   return true;
 }
@@ -828,6 +1018,9 @@ ImBuf *IMB_scale_into_new(
     case IMBScaleFilter::Bilinear:
       scale_bilinear_func(ibuf, newx, newy, dst_byte, dst_float, threaded);
       break;
+    case IMBScaleFilter::Lanczos:
+      scale_lanczos_func(ibuf, newx, newy, dst_byte, dst_float, threaded);
+      break;
     case IMBScaleFilter::Box: {
       /* Horizontal scale. */
       uchar4 *tmp_byte = nullptr;
@@ -837,7 +1030,7 @@ ImBuf *IMB_scale_into_new(
         if (dst_byte != nullptr) {
           MEM_freeN(dst_byte);
         }
-        if (dst_byte != nullptr) {
+        if (dst_float != nullptr) {
           MEM_freeN(dst_float);
         }
         return nullptr;
@@ -13,10 +13,12 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <sys/types.h>
 
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -604,7 +606,7 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
 
   if (anim->ib_flags & IB_animdeinterlace) {
     if (ffmpeg_deinterlace(anim->pFrameDeinterlaced,
-                           anim->pFrame,
+                           input,
                            anim->pCodecCtx->pix_fmt,
                            anim->pCodecCtx->width,
                            anim->pCodecCtx->height) < 0)
@@ -628,20 +630,24 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
                        anim->pFrameRGB->linesize[2] == src_linesize &&
                        anim->pFrameRGB->linesize[3] == src_linesize,
                    "ffmpeg frame should be 4 same size planes for a floating point image case");
-    for (int y = 0; y < ibuf->y; y++) {
-      size_t src_offset = src_linesize * (ibuf->y - y - 1);
-      const float *src_g = reinterpret_cast<const float *>(anim->pFrameRGB->data[0] + src_offset);
-      const float *src_b = reinterpret_cast<const float *>(anim->pFrameRGB->data[1] + src_offset);
-      const float *src_r = reinterpret_cast<const float *>(anim->pFrameRGB->data[2] + src_offset);
-      const float *src_a = reinterpret_cast<const float *>(anim->pFrameRGB->data[3] + src_offset);
-      float *dst = ibuf->float_buffer.data + ibuf->x * y * 4;
-      for (int x = 0; x < ibuf->x; x++) {
-        *dst++ = *src_r++;
-        *dst++ = *src_g++;
-        *dst++ = *src_b++;
-        *dst++ = *src_a++;
-      }
-    }
+    const AVFrame *planes = anim->pFrameRGB;
+    blender::threading::parallel_for(
+        blender::IndexRange(ibuf->y), 64, [&](const blender::IndexRange y_range) {
+          for (const int64_t y : y_range) {
+            size_t src_offset = src_linesize * (ibuf->y - y - 1);
+            const float *src_g = reinterpret_cast<const float *>(planes->data[0] + src_offset);
+            const float *src_b = reinterpret_cast<const float *>(planes->data[1] + src_offset);
+            const float *src_r = reinterpret_cast<const float *>(planes->data[2] + src_offset);
+            const float *src_a = reinterpret_cast<const float *>(planes->data[3] + src_offset);
+            float *dst = ibuf->float_buffer.data + size_t(ibuf->x) * y * 4;
+            for (int x = 0; x < ibuf->x; x++) {
+              *dst++ = *src_r++;
+              *dst++ = *src_g++;
+              *dst++ = *src_b++;
+              *dst++ = *src_a++;
+            }
+          }
+        });
   }
   else {
     /* If final destination image layout matches that of decoded RGB frame (including
@@ -674,22 +680,15 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
       /* Decode, then do vertical flip into destination. */
       ffmpeg_sws_scale_frame(anim->img_convert_ctx, anim->pFrameRGB, input);
 
-      /* Use negative line size to do vertical image flip. */
-      const int src_linesize[4] = {-rgb_linesize, 0, 0, 0};
-      const uint8_t *const src[4] = {
-          rgb_data + (anim->y - 1) * rgb_linesize, nullptr, nullptr, nullptr};
-      int dst_size = av_image_get_buffer_size(AVPixelFormat(anim->pFrameRGB->format),
-                                              anim->pFrameRGB->width,
-                                              anim->pFrameRGB->height,
-                                              1);
-      av_image_copy_to_buffer(ibuf->byte_buffer.data,
-                              dst_size,
-                              src,
-                              src_linesize,
-                              AVPixelFormat(anim->pFrameRGB->format),
-                              anim->x,
-                              anim->y,
-                              1);
+      /* Copy rows in reverse order to do vertical image flip. */
+      blender::threading::parallel_for(
+          blender::IndexRange(ibuf->y), 256, [&](const blender::IndexRange y_range) {
+            for (const int64_t y : y_range) {
+              memcpy(ibuf->byte_buffer.data + y * ibuf_linesize,
+                     rgb_data + (ibuf->y - y - 1) * rgb_linesize,
+                     ibuf_linesize);
+            }
+          });
     }
   }
 
@@ -1139,6 +1138,161 @@ static bool ffmpeg_must_seek(MovieReader *anim, int position)
   return must_seek;
 }
 
+/* Number of frames the decode-ahead thread keeps decoded past the last fetched frame. */
+#  define FFMPEG_DECODE_AHEAD_FRAMES 4
+
+/* Drop the frames decoded ahead. The decoder is then past the current frame, so the decoder
+ * position is reset to make the next seek flush the decoder instead of scanning forward from the
+ * current stream position. */
+static void ffmpeg_decode_ahead_frames_clear(MovieReader *anim)
+{
+  if (anim->decode_ahead_frames.is_empty()) {
+    return;
+  }
+  for (AVFrame *frame : anim->decode_ahead_frames) {
+    av_frame_free(&frame);
+  }
+  anim->decode_ahead_frames.clear();
+  anim->cur_pts = -1;
+  anim->cur_key_frame_pts = -1;
+}
+
+/* Decode the frame following the most recently decoded one. The current frame is left in place,
+ * since the same position may be requested again. Returns nullptr at the end of the stream or on
+ * decoding errors. */
+static AVFrame *ffmpeg_decode_ahead_frame(MovieReader *anim)
+{
+  AVFrame *current_frame = anim->pFrame;
+  const bool current_frame_complete = anim->pFrame_complete;
+
+  anim->pFrame = av_frame_alloc();
+  const bool decoded = ffmpeg_decode_video_frame(anim) && anim->pFrame_complete;
+  AVFrame *decoded_frame = anim->pFrame;
+
+  anim->pFrame = current_frame;
+  anim->pFrame_complete = current_frame_complete;
+
+  if (!decoded) {
+    av_frame_free(&decoded_frame);
+    return nullptr;
+  }
+  return decoded_frame;
+}
+
+static void ffmpeg_decode_ahead_thread(MovieReader *anim)
+{
+  std::unique_lock lock(anim->decode_mutex);
+  while (true) {
+    /* Sleep until a fetch took frames from a full queue, and let waiting fetches go first. */
+    anim->decode_ahead_cond.wait(lock, [&]() {
+      return anim->decode_ahead_stop ||
+             (anim->decode_ahead_active && !anim->decode_ahead_fetch_waiting &&
+              anim->decode_ahead_frames.size() < FFMPEG_DECODE_AHEAD_FRAMES);
+    });
+    if (anim->decode_ahead_stop) {
+      break;
+    }
+
+    /* Decode without holding the mutex, the busy flag keeps fetches away from the decoder state
+     * in the meantime. */
+    anim->decode_ahead_busy = true;
+    lock.unlock();
+    AVFrame *frame = ffmpeg_decode_ahead_frame(anim);
+    lock.lock();
+    anim->decode_ahead_busy = false;
+
+    if (frame) {
+      anim->decode_ahead_frames.append(frame);
+    }
+    else {
+      anim->decode_ahead_active = false;
+    }
+    anim->decode_ahead_cond.notify_all();
+  }
+}
+
+/* Lock the decoder state of the reader, waiting for the decode-ahead thread to finish the frame it
+ * is decoding, if any. */
+static std::unique_lock<std::mutex> ffmpeg_decoder_lock(MovieReader *anim)
+{
+  std::unique_lock lock(anim->decode_mutex);
+  anim->decode_ahead_fetch_waiting = true;
+  anim->decode_ahead_cond.wait(lock, [&]() { return !anim->decode_ahead_busy; });
+  anim->decode_ahead_fetch_waiting = false;
+  return lock;
+}
+
+/* Make the frame matching `pts_to_search` from the decode-ahead queue the current frame, dropping
+ * it and the frames before it from the queue. Returns nullptr if the queue has no such frame, in
+ * which case the decoder is past the requested position, so the queue is cleared and the current
+ * frame is invalidated to force a seek. */
+static AVFrame *ffmpeg_decode_ahead_frame_take(MovieReader *anim, int64_t pts_to_search)
+{
+  blender::Vector<AVFrame *> &frames = anim->decode_ahead_frames;
+  if (frames.is_empty()) {
+    return nullptr;
+  }
+
+  for (const int64_t i : frames.index_range()) {
+    /* Like for the backup frame, a gap before the next frame of VFR movies belongs to this one. */
+    const int64_t frame_start = av_get_pts_from_frame(frames[i]);
+    const int64_t frame_end = i + 1 < frames.size() ?
+                                  av_get_pts_from_frame(frames[i + 1]) :
+                                  frame_start + av_get_frame_duration_in_pts_units(frames[i]);
+    if (!ffmpeg_pts_isect(frame_start, frame_end, pts_to_search)) {
+      continue;
+    }
+
+    final_frame_log(anim, frame_start, frame_end, "Decoded ahead");
+    av_frame_unref(anim->pFrame);
+    av_frame_move_ref(anim->pFrame, frames[i]);
+    anim->pFrame_complete = true;
+    ffmpeg_double_buffer_backup_frame_clear(anim);
+
+    for (AVFrame *frame : frames.as_span().take_front(i + 1)) {
+      av_frame_free(&frame);
+    }
+    frames.remove(0, i + 1);
+    return anim->pFrame;
+  }
+
+  ffmpeg_decode_ahead_frames_clear(anim);
+  av_frame_unref(anim->pFrame);
+  anim->pFrame_complete = false;
+  return nullptr;
+}
+
+/* Decode ahead while frames are fetched sequentially. The thread is only started once the movie is
+ * actually played back, and stopped again when playback stops, see ffmpeg_decode_ahead_stop. */
+static void ffmpeg_decode_ahead_update(MovieReader *anim, int position)
+{
+  if (anim->never_seek_decode_one_frame) {
+    return;
+  }
+
+  anim->decode_ahead_active = position == anim->cur_position + 1;
+  if (anim->decode_ahead_active && !anim->decode_ahead_thread.joinable()) {
+    anim->decode_ahead_thread = std::thread(ffmpeg_decode_ahead_thread, anim);
+  }
+}
+
+/* Stop the decode-ahead thread and drop the frames it decoded. Must be called without holding the
+ * decoder mutex. */
+static void ffmpeg_decode_ahead_stop(MovieReader *anim)
+{
+  if (anim->decode_ahead_thread.joinable()) {
+    {
+      std::lock_guard lock(anim->decode_mutex);
+      anim->decode_ahead_stop = true;
+    }
+    anim->decode_ahead_cond.notify_all();
+    anim->decode_ahead_thread.join();
+    anim->decode_ahead_stop = false;
+  }
+  anim->decode_ahead_active = false;
+  ffmpeg_decode_ahead_frames_clear(anim);
+}
+
 static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Type tc)
 {
   if (anim == nullptr) {
@@ -1147,6 +1301,14 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
 
   av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: seek_pos=%d\n", position);
 
+  /* Sequential playback stopped, for instance because of scrubbing, so stop decoding ahead. Frames
+   * are still decoded ahead when the same frame is fetched again. */
+  if (position != anim->cur_position + 1 && position != anim->cur_position) {
+    ffmpeg_decode_ahead_stop(anim);
+  }
+
+  std::unique_lock lock = ffmpeg_decoder_lock(anim);
+
   const MovieIndex *tc_index = movie_open_index(anim, tc);
   int64_t pts_to_search = ffmpeg_get_pts_to_search(anim, tc_index, position);
   AVStream *v_st = anim->pFormatCtx->streams[anim->videoStream];
@@ -1171,7 +1333,9 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
            frame_rate,
            start_pts);
 
-    if (ffmpeg_must_decode(anim, position)) {
+    if (ffmpeg_must_decode(anim, position) &&
+        ffmpeg_decode_ahead_frame_take(anim, pts_to_search) == nullptr)
+    {
       if (ffmpeg_must_seek(anim, position)) {
         ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
       }
@@ -1214,14 +1378,25 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     final_frame = ffmpeg_double_buffer_frame_fallback_get(anim);
   }
 
+  /* Keep a reference to the frame, so the decode-ahead thread can continue decoding while it is
+   * converted into the image buffer. */
+  if (final_frame != nullptr) {
+    final_frame = av_frame_clone(final_frame);
+  }
+
+  ffmpeg_decode_ahead_update(anim, position);
+  anim->cur_position = position;
+
+  lock.unlock();
+  anim->decode_ahead_cond.notify_all();
+
   /* Even with the fallback from above it is possible that the current decode frame is nullptr. In
    * this case skip post-processing and return current image buffer. */
   if (final_frame != nullptr) {
     ffmpeg_postprocess(anim, final_frame, cur_frame_final);
+    av_frame_free(&final_frame);
   }
 
-  anim->cur_position = position;
-
   return cur_frame_final;
 }
 
@@ -1231,6 +1406,8 @@ static void free_anim_ffmpeg(MovieReader *anim)
     return;
   }
 
+  ffmpeg_decode_ahead_stop(anim);
+
   if (anim->pCodecCtx) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
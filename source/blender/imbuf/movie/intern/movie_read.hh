@@ -14,6 +14,11 @@
 #include "IMB_imbuf_enums.h"
 
 #ifdef WITH_FFMPEG
+#  include <condition_variable>
+#  include <mutex>
+#  include <thread>
+
+#  include "BLI_vector.hh"
 
 extern "C" {
 #  include <libavutil/rational.h>
@@ -77,6 +82,23 @@ struct MovieReader {
    * ffmpeg crashes/aborts when trying to seek within them
    * (https://trac.ffmpeg.org/ticket/10755). */
   bool never_seek_decode_one_frame = false;
+
+  /* Decode-ahead pipeline. During sequential playback a dedicated thread keeps decoding the frames
+   * following the last fetched one into a small queue sorted by PTS, so that the next fetch only
+   * has to convert the frame. The mutex guards all decoder state of the reader, including the
+   * queue. The decode-ahead thread releases it while decoding a frame, setting the busy flag, and
+   * fetches wait on the condition variable until the thread is no longer busy. */
+  std::mutex decode_mutex;
+  std::condition_variable decode_ahead_cond;
+  std::thread decode_ahead_thread;
+  blender::Vector<AVFrame *> decode_ahead_frames;
+  /* Set while frames are fetched sequentially, cleared on scrubbing and at the end of stream. */
+  bool decode_ahead_active = false;
+  bool decode_ahead_stop = false;
+  /* Set while the decode-ahead thread decodes a frame without holding the mutex. */
+  bool decode_ahead_busy = false;
+  /* Set while a fetch waits for the decoder, such that the decode-ahead thread yields to it. */
+  bool decode_ahead_fetch_waiting = false;
 #endif
 
   char index_dir[768] = {};
@@ -0,0 +1,119 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <string>
+
+#include "BLI_path_utils.hh"
+#include "BLI_vector.hh"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "MOV_read.hh"
+
+namespace ffmpeg::tests {
+
+using namespace blender;
+
+/* Frames are decoded ahead on a separate thread while they are fetched sequentially, and the
+ * frames are compared to those of a second reader which only fetches frames in descending order,
+ * such that frames are never decoded ahead. */
+class MovieReadTest : public ::testing::Test {
+ public:
+  MovieReader *reader = nullptr;
+  MovieReader *reference_reader = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+
+  void SetUp() override
+  {
+    const std::string filepath = blender::tests::flags_test_asset_dir() + SEP_STR + "ffmpeg" +
+                                 SEP_STR + "T126866.mp4";
+    char colorspace[IM_MAX_SPACE] = "";
+    reader = MOV_open_file(filepath.c_str(), IB_rect, 0, colorspace);
+    char reference_colorspace[IM_MAX_SPACE] = "";
+    reference_reader = MOV_open_file(filepath.c_str(), IB_rect, 0, reference_colorspace);
+  }
+
+  void TearDown() override
+  {
+    MOV_close(reader);
+    MOV_close(reference_reader);
+  }
+
+  /* Decode the given frames with the reference reader, in descending order. */
+  Vector<ImBuf *> decode_reference_frames(const int frames_num)
+  {
+    Vector<ImBuf *> frames(frames_num, nullptr);
+    for (int position = frames_num - 1; position >= 0; position--) {
+      frames[position] = MOV_decode_frame(reference_reader, position, IMB_TC_NONE, IMB_PROXY_NONE);
+    }
+    return frames;
+  }
+
+  static void expect_frames_eq(const ImBuf *ibuf, const ImBuf *reference, const int position)
+  {
+    ASSERT_NE(ibuf, nullptr) << "Frame " << position;
+    ASSERT_NE(reference, nullptr) << "Frame " << position;
+    ASSERT_EQ(ibuf->x, reference->x);
+    ASSERT_EQ(ibuf->y, reference->y);
+    ASSERT_NE(ibuf->byte_buffer.data, nullptr);
+    EXPECT_EQ(std::memcmp(ibuf->byte_buffer.data,
+                          reference->byte_buffer.data,
+                          size_t(ibuf->x) * ibuf->y * 4),
+              0)
+        << "Frame " << position;
+  }
+};
+
+TEST_F(MovieReadTest, sequential_matches_reference)
+{
+  const int frames_num = 40;
+  ASSERT_GE(MOV_get_duration_frames(reader, IMB_TC_NONE), frames_num);
+  Vector<ImBuf *> reference_frames = decode_reference_frames(frames_num);
+
+  for (const int position : IndexRange(frames_num)) {
+    ImBuf *ibuf = MOV_decode_frame(reader, position, IMB_TC_NONE, IMB_PROXY_NONE);
+    expect_frames_eq(ibuf, reference_frames[position], position);
+    IMB_freeImBuf(ibuf);
+  }
+
+  for (ImBuf *ibuf : reference_frames) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
+TEST_F(MovieReadTest, scrub_matches_reference)
+{
+  const int frames_num = 40;
+  ASSERT_GE(MOV_get_duration_frames(reader, IMB_TC_NONE), frames_num);
+  Vector<ImBuf *> reference_frames = decode_reference_frames(frames_num);
+
+  /* Sequential runs interrupted by jumps forward within and past the frames decoded ahead, jumps
+   * backward, and repeated fetches of the same frame. */
+  const int positions[] = {0,  1,  2,  3,  4,  6,  7,  8,  8,  9,  10, 30, 31, 32,
+                           12, 13, 14, 15, 16, 17, 18, 19, 2,  3,  4,  5,  39, 38};
+  for (const int position : positions) {
+    ImBuf *ibuf = MOV_decode_frame(reader, position, IMB_TC_NONE, IMB_PROXY_NONE);
+    expect_frames_eq(ibuf, reference_frames[position], position);
+    IMB_freeImBuf(ibuf);
+  }
+
+  for (ImBuf *ibuf : reference_frames) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
+}  // namespace ffmpeg::tests
@@ -0,0 +1,174 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_string.h"
+
+#include "DNA_color_types.h"
+
+#include "IMB_colormanagement.hh"
+#include "IMB_imbuf.hh"
+
+#include <ocio_capi.h>
+
+namespace blender::imbuf::tests {
+
+/* Transforms from scene linear to sRGB might be applied by a vectorized approximation of the sRGB
+ * conversion instead of OCIO, the results of both are compared. */
+class ColormanagementTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+};
+
+/* Pixels with negative, small and large values, different alphas including zero, and more pixels
+ * than the conversion processes at once. */
+static Array<float4> create_test_pixels()
+{
+  const float values[] = {
+      -0.5f, -0.01f, 0.0f, 0.002f, 0.0031308f, 0.05f, 0.18f, 0.5f, 0.9f, 1.0f, 2.5f, 12.0f};
+  const float alphas[] = {1.0f, 0.5f, 0.0f, 0.25f, 1.0f};
+  const int values_num = ARRAY_SIZE(values);
+
+  Array<float4> pixels(values_num * values_num * 3);
+  for (const int i : pixels.index_range()) {
+    pixels[i] = float4(values[i % values_num],
+                       values[(i / values_num) % values_num],
+                       values[(i * 7 + 3) % values_num],
+                       alphas[i % ARRAY_SIZE(alphas)]);
+  }
+  return pixels;
+}
+
+static void apply_ocio(OCIO_ConstProcessorRcPtr *processor,
+                       MutableSpan<float4> pixels,
+                       const bool predivide)
+{
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(reinterpret_cast<float *>(
+                                                                  pixels.data()),
+                                                              pixels.size(),
+                                                              1,
+                                                              4,
+                                                              sizeof(float),
+                                                              sizeof(float4),
+                                                              sizeof(float4) * pixels.size());
+  if (predivide) {
+    OCIO_cpuProcessorApply_predivide(cpu_processor, img);
+  }
+  else {
+    OCIO_cpuProcessorApply(cpu_processor, img);
+  }
+  OCIO_PackedImageDescRelease(img);
+  OCIO_cpuProcessorRelease(cpu_processor);
+}
+
+static void expect_pixels_near(const Span<float4> pixels, const Span<float4> expected)
+{
+  for (const int i : pixels.index_range()) {
+    for (const int c : IndexRange(4)) {
+      EXPECT_NEAR(pixels[i][c], expected[i][c], 1e-3f * std::max(1.0f, std::abs(expected[i][c])))
+          << "Pixel " << i << " channel " << c;
+    }
+  }
+}
+
+static void expect_processor_matches_ocio(ColormanageProcessor *cm_processor,
+                                          OCIO_ConstProcessorRcPtr *ocio_processor)
+{
+  ASSERT_NE(cm_processor, nullptr);
+  ASSERT_NE(ocio_processor, nullptr);
+
+  for (const bool predivide : {false, true}) {
+    Array<float4> pixels = create_test_pixels();
+    Array<float4> expected = pixels;
+    apply_ocio(ocio_processor, expected, predivide);
+
+    /* Buffers. */
+    Array<float4> buffer = pixels;
+    IMB_colormanagement_processor_apply(cm_processor,
+                                        reinterpret_cast<float *>(buffer.data()),
+                                        int(buffer.size()),
+                                        1,
+                                        4,
+                                        predivide);
+    expect_pixels_near(buffer, expected);
+
+    /* Single pixels. */
+    Array<float4> single_pixels = pixels;
+    for (float4 &pixel : single_pixels) {
+      if (predivide) {
+        IMB_colormanagement_processor_apply_v4_predivide(cm_processor, pixel);
+      }
+      else {
+        IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
+      }
+    }
+    expect_pixels_near(single_pixels, expected);
+  }
+}
+
+TEST_F(ColormanagementTest, display_processor_matches_ocio)
+{
+  ColorManagedDisplaySettings display_settings = {};
+  STRNCPY(display_settings.display_device, IMB_colormanagement_display_get_default_name());
+  ColorManagedViewSettings view_settings = {};
+  IMB_colormanagement_init_default_view_settings(&view_settings, &display_settings);
+
+  ColormanageProcessor *cm_processor = IMB_colormanagement_display_processor_new(
+      &view_settings, &display_settings);
+
+  OCIO_ConstConfigRcPtr *config = OCIO_getCurrentConfig();
+  OCIO_ConstProcessorRcPtr *ocio_processor = OCIO_createDisplayProcessor(
+      config,
+      IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_SCENE_LINEAR),
+      view_settings.view_transform,
+      display_settings.display_device,
+      "",
+      1.0f,
+      1.0f,
+      view_settings.temperature,
+      view_settings.tint,
+      false,
+      false);
+  OCIO_configRelease(config);
+
+  expect_processor_matches_ocio(cm_processor, ocio_processor);
+
+  OCIO_processorRelease(ocio_processor);
+  IMB_colormanagement_processor_free(cm_processor);
+}
+
+TEST_F(ColormanagementTest, colorspace_processor_matches_ocio)
+{
+  const char *scene_linear = IMB_colormanagement_role_colorspace_name_get(
+      COLOR_ROLE_SCENE_LINEAR);
+  ColormanageProcessor *cm_processor = IMB_colormanagement_colorspace_processor_new(scene_linear,
+                                                                                    "sRGB");
+
+  OCIO_ConstConfigRcPtr *config = OCIO_getCurrentConfig();
+  OCIO_ConstProcessorRcPtr *ocio_processor = OCIO_configGetProcessorWithNames(
+      config, scene_linear, "sRGB");
+  OCIO_configRelease(config);
+
+  expect_processor_matches_ocio(cm_processor, ocio_processor);
+
+  OCIO_processorRelease(ocio_processor);
+  IMB_colormanagement_processor_free(cm_processor);
+}
+
+}  // namespace blender::imbuf::tests
@@ -4,6 +4,9 @@
 
 #include "testing/testing.h"
 
+#include "BLI_array.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 #include "IMB_imbuf.hh"
 
@@ -294,4 +297,161 @@ TEST(imbuf_scaling, threaded_2x_smaller_fl4)
   IMB_freeImBuf(res);
 }
 
+TEST(imbuf_scaling, lanczos_2x_smaller)
+{
+  ImBuf *res = create_6x2_test_image();
+  IMB_scale(res, 3, 1, IMBScaleFilter::Lanczos, true);
+  const uchar4 *got = reinterpret_cast<uchar4 *>(res->byte_buffer.data);
+  EXPECT_EQ(uint4(got[0]), uint4(186, 121, 59, 238));
+  EXPECT_EQ(uint4(got[1]), uint4(145, 69, 44, 42));
+  EXPECT_EQ(uint4(got[2]), uint4(55, 46, 44, 237));
+  IMB_freeImBuf(res);
+}
+
+TEST(imbuf_scaling, lanczos_fractional_larger)
+{
+  ImBuf *res = create_6x2_test_image();
+  IMB_scale(res, 9, 7, IMBScaleFilter::Lanczos, true);
+  const uchar4 *got = reinterpret_cast<uchar4 *>(res->byte_buffer.data);
+  EXPECT_EQ(uint4(got[0 + 0 * res->x]), uint4(0, 0, 4, 249));
+  EXPECT_EQ(uint4(got[1 + 0 * res->x]), uint4(126, 0, 0, 255));
+  EXPECT_EQ(uint4(got[7 + 0 * res->x]), uint4(43, 130, 4, 255));
+  EXPECT_EQ(uint4(got[2 + 2 * res->x]), uint4(255, 46, 46, 225));
+  EXPECT_EQ(uint4(got[3 + 2 * res->x]), uint4(155, 56, 34, 51));
+  EXPECT_EQ(uint4(got[8 + 6 * res->x]), uint4(59, 4, 105, 246));
+  IMB_freeImBuf(res);
+}
+
+TEST(imbuf_scaling, lanczos_2x_smaller_fl4)
+{
+  ImBuf *res = create_6x2_test_image_fl(4);
+  IMB_scale(res, 3, 1, IMBScaleFilter::Lanczos, false);
+  const float4 *got = reinterpret_cast<float4 *>(res->float_buffer.data);
+  EXPECT_V4_NEAR(got[0], float4(0.84402f, 0.96902f, 1.09402f, 1.21902f), EPS);
+  EXPECT_V4_NEAR(got[1], float4(3.375f, 3.5f, 3.625f, 3.75f), EPS);
+  EXPECT_V4_NEAR(got[2], float4(5.90598f, 6.03098f, 6.15598f, 6.28098f), EPS);
+  IMB_freeImBuf(res);
+}
+
+/* The vertical box filter passes used to walk down each column, they now process whole rows. The
+ * column walks are kept here as reference, results must stay identical. */
+static void reference_box_down_y(
+    const float4 *src, float4 *dst, int width, int height, int new_height)
+{
+  const float add = (height - 0.01f) / new_height;
+  const float inv_add = 1.0f / add;
+  for (int x = 0; x < width; x++) {
+    const float4 *src_ptr = src + x;
+    float4 *dst_ptr = dst + x;
+    float sample = 0.0f;
+    float4 val(0.0f);
+    for (int y = 0; y < new_height; y++) {
+      float4 nval = -val * sample;
+      sample += add;
+      while (sample >= 1.0f) {
+        sample -= 1.0f;
+        nval += *src_ptr;
+        src_ptr += width;
+      }
+      val = *src_ptr;
+      src_ptr += width;
+      *dst_ptr = (nval + sample * val) * inv_add;
+      dst_ptr += width;
+      sample -= 1.0f;
+    }
+  }
+}
+
+static void reference_box_up_y(
+    const float4 *src, float4 *dst, int width, int height, int new_height)
+{
+  const float add = (height - 0.001f) / new_height;
+  for (int x = 0; x < width; x++) {
+    float sample = -0.5f + add * 0.5f;
+    int counter = 0;
+    const float4 *src_ptr = src + x;
+    float4 *dst_ptr = dst + x;
+    float4 val = src_ptr[0];
+    float4 nval = src_ptr[width];
+    float4 diff = nval - val;
+    if (height > 2) {
+      src_ptr += width * 2;
+      counter += 2;
+    }
+    for (int y = 0; y < new_height; y++) {
+      if (sample >= 1.0f) {
+        sample -= 1.0f;
+        val = nval;
+        nval = *src_ptr;
+        diff = nval - val;
+        if (counter + 1 < height) {
+          src_ptr += width;
+          counter++;
+        }
+      }
+      *dst_ptr = val + math::max(sample, 0.0f) * diff;
+      dst_ptr += width;
+      sample += add;
+    }
+  }
+}
+
+static float4 box_test_pixel(int x, int y)
+{
+  return float4((x * 37 + y * 11) % 256, (x * 5 + y * 97) % 256, (x * y * 3) % 256, 255 - y);
+}
+
+static void test_box_vertical_matches_column_walk(int width, int height, int new_height)
+{
+  Array<float4> src(width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      src[y * width + x] = box_test_pixel(x, y);
+    }
+  }
+  Array<float4> expected(width * new_height);
+  if (new_height < height) {
+    reference_box_down_y(src.data(), expected.data(), width, height, new_height);
+  }
+  else {
+    reference_box_up_y(src.data(), expected.data(), width, height, new_height);
+  }
+
+  for (const bool threaded : {false, true}) {
+    ImBuf *img = IMB_allocImBuf(width, height, 32, IB_rect | IB_rectfloat);
+    uchar4 *src_byte = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+    float4 *src_float = reinterpret_cast<float4 *>(img->float_buffer.data);
+    for (const int i : src.index_range()) {
+      src_byte[i] = uchar4(src[i]);
+      src_float[i] = src[i];
+    }
+    IMB_scale(img, width, new_height, IMBScaleFilter::Box, threaded);
+    ASSERT_EQ(img->y, new_height);
+
+    const uchar4 *got_byte = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+    const float4 *got_float = reinterpret_cast<float4 *>(img->float_buffer.data);
+    for (const int i : expected.index_range()) {
+      EXPECT_EQ(uint4(got_byte[i]), uint4(uchar4(math::round(expected[i])))) << "Pixel " << i;
+      EXPECT_EQ(got_float[i], expected[i]) << "Pixel " << i;
+    }
+    IMB_freeImBuf(img);
+  }
+}
+
+TEST(imbuf_scaling, box_down_y_matches_column_walk)
+{
+  test_box_vertical_matches_column_walk(37, 23, 7);
+  test_box_vertical_matches_column_walk(13, 101, 33);
+  test_box_vertical_matches_column_walk(5, 37, 1);
+  test_box_vertical_matches_column_walk(1, 19, 11);
+}
+
+TEST(imbuf_scaling, box_up_y_matches_column_walk)
+{
+  test_box_vertical_matches_column_walk(37, 7, 23);
+  test_box_vertical_matches_column_walk(13, 2, 9);
+  test_box_vertical_matches_column_walk(5, 3, 101);
+  test_box_vertical_matches_column_walk(1, 11, 19);
+}
+
 }  // namespace blender::imbuf::tests
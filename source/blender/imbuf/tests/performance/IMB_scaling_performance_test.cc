@@ -100,6 +100,14 @@ static void imb_scale_box(ImBuf *&src, int width, int height)
 {
   IMB_scale(src, width, height, IMBScaleFilter::Box, true);
 }
+static void imb_scale_lanczos_st(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::Lanczos, false);
+}
+static void imb_scale_lanczos(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::Lanczos, true);
+}
 
 static void scale_perf_impl(const char *name,
                             bool use_float,
@@ -129,6 +137,32 @@ static void test_scaling_perf(bool use_float)
   scale_perf_impl("scale_boxfl_s", use_float, imb_scale_box_st);
   scale_perf_impl("scale_boxfl_m", use_float, imb_scale_box);
   scale_perf_impl("xform_boxfl_m", use_float, imb_xform_box);
+
+  scale_perf_impl("scale_lancz_s", use_float, imb_scale_lanczos_st);
+  scale_perf_impl("scale_lancz_m", use_float, imb_scale_lanczos);
+}
+
+/* Sequencer proxies are scaled down to 25%, 50% or 75% into a new image. */
+static void proxy_perf_impl(const char *name, bool use_float, IMBScaleFilter filter)
+{
+  ImBuf *img = create_src_image(use_float);
+  {
+    SCOPED_TIMER(name);
+    for (const int percent : {25, 50, 75}) {
+      ImBuf *res = IMB_scale_into_new(
+          img, SRC_X * percent / 100, SRC_Y * percent / 100, filter, true);
+      IMB_freeImBuf(res);
+    }
+  }
+  IMB_freeImBuf(img);
+}
+
+static void test_proxy_perf(bool use_float)
+{
+  proxy_perf_impl("proxy_neare_m", use_float, IMBScaleFilter::Nearest);
+  proxy_perf_impl("proxy_bilin_m", use_float, IMBScaleFilter::Bilinear);
+  proxy_perf_impl("proxy_boxfl_m", use_float, IMBScaleFilter::Box);
+  proxy_perf_impl("proxy_lancz_m", use_float, IMBScaleFilter::Lanczos);
 }
 
 TEST(imbuf_scaling, scaling_perf_byte)
@@ -140,3 +174,13 @@ TEST(imbuf_scaling, scaling_perf_float)
 {
   test_scaling_perf(true);
 }
+
+TEST(imbuf_scaling, proxy_perf_byte)
+{
+  test_proxy_perf(false);
+}
+
+TEST(imbuf_scaling, proxy_perf_float)
+{
+  test_proxy_perf(true);
+}
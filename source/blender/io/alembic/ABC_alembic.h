@@ -53,6 +53,11 @@ struct AlembicExportParams {
   bool use_instancing;
   enum eEvaluationMode evaluation_mode;
 
+  /* Number of frames to keep evaluated at the same time, each on its own depsgraph, so that
+   * upcoming frames are evaluated while a frame is written. Frames are only evaluated ahead when
+   * they don't depend on each other (no simulation caches). */
+  int parallel_frames;
+
   /* See MOD_TRIANGULATE_NGON_xxx and MOD_TRIANGULATE_QUAD_xxx
    * in DNA_modifier_types.h */
   int quad_method;
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "ABC_alembic.h"
+#include "IO_multi_frame_evaluator.hh"
 #include "IO_subdiv_disabler.hh"
 #include "abc_archive.h"
 #include "abc_hierarchy_iterator.h"
@@ -42,6 +43,9 @@ struct ExportJobData {
   char filepath[FILE_MAX] = {};
   AlembicExportParams params = {};
 
+  /* Evaluates the frames of animation exports, built along with #depsgraph on the main thread. */
+  std::unique_ptr<blender::io::MultiFrameEvaluator> frame_evaluator;
+
   bool was_canceled = false;
   bool export_ok = false;
   blender::timeit::TimePoint start_time = {};
@@ -50,7 +54,7 @@ struct ExportJobData {
 namespace blender::io::alembic {
 
 /* Construct the depsgraph for exporting. */
-static bool build_depsgraph(ExportJobData *job)
+static bool build_depsgraph(const ExportJobData *job, Depsgraph *depsgraph)
 {
   if (job->params.collection[0]) {
     Collection *collection = reinterpret_cast<Collection *>(
@@ -61,13 +65,13 @@ static bool build_depsgraph(ExportJobData *job)
       return false;
     }
 
-    DEG_graph_build_from_collection(job->depsgraph, collection);
+    DEG_graph_build_from_collection(depsgraph, collection);
   }
   else if (job->params.visible_objects_only) {
-    DEG_graph_build_from_view_layer(job->depsgraph);
+    DEG_graph_build_from_view_layer(depsgraph);
   }
   else {
-    DEG_graph_build_for_all_objects(job->depsgraph);
+    DEG_graph_build_for_all_objects(depsgraph);
   }
 
   return true;
@@ -139,31 +143,30 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
   if (export_animation) {
     CLOG_INFO(&LOG, 2, "Exporting animation");
 
+    /* Upcoming frames may be evaluated in the background while a frame is written. Writing
+     * always happens in frame order. */
+    MultiFrameEvaluator &frame_evaluator = *data->frame_evaluator;
+    const Vector<double> frames(abc_archive->frames_begin(), abc_archive->frames_end());
+
     /* Writing the animated frames is not 100% of the work, but it's our best guess. */
     const float progress_per_frame = 1.0f / std::max(size_t(1), abc_archive->total_frame_count());
-    ABCArchive::Frames::const_iterator frame_it = abc_archive->frames_begin();
-    const ABCArchive::Frames::const_iterator frames_end = abc_archive->frames_end();
-
-    for (; frame_it != frames_end; frame_it++) {
-      double frame = *frame_it;
-
-      if (G.is_break || worker_status->stop) {
-        break;
-      }
 
-      /* Update the scene for the next frame to render. */
-      scene->r.cfra = int(frame);
-      scene->r.subframe = float(frame - scene->r.cfra);
-      BKE_scene_graph_update_for_newframe(data->depsgraph);
-
-      CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
-      ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
-      iter.set_export_subset(export_subset);
-      iter.iterate_and_write();
-
-      worker_status->progress += progress_per_frame;
-      worker_status->do_update = true;
-    }
+    frame_evaluator.foreach_frame(
+        frames,
+        [&]() { return G.is_break || worker_status->stop; },
+        [&](const double frame, Depsgraph *depsgraph) {
+          CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
+          ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
+          iter.set_depsgraph(depsgraph);
+          iter.set_export_subset(export_subset);
+          iter.iterate_and_write();
+
+          worker_status->progress += progress_per_frame;
+          worker_status->do_update = true;
+        });
+
+    /* The extra depsgraphs are freed with the frame evaluator, in #export_endjob. */
+    iter.set_depsgraph(data->depsgraph);
   }
   else {
     /* If we're not animating, a single iteration over all objects is enough. */
@@ -188,6 +191,7 @@ static void export_endjob(void *customdata)
 {
   ExportJobData *data = static_cast<ExportJobData *>(customdata);
 
+  data->frame_evaluator.reset();
   DEG_graph_free(data->depsgraph);
 
   if (data->was_canceled && BLI_exists(data->filepath)) {
@@ -223,9 +227,16 @@ bool ABC_export(Scene *scene,
    *
    * Has to be done from main thread currently, as it may affect Main original data (e.g. when
    * doing deferred update of the view-layers, see #112534 for details). */
-  if (!blender::io::alembic::build_depsgraph(job)) {
+  if (!blender::io::alembic::build_depsgraph(job, job->depsgraph)) {
     return false;
   }
+  if (params->frame_start != params->frame_end) {
+    /* The extra depsgraphs for parallel frame evaluation are built here for the same reason. */
+    job->frame_evaluator = std::make_unique<blender::io::MultiFrameEvaluator>(
+        job->depsgraph, params->parallel_frames, [&](Depsgraph *depsgraph) {
+          blender::io::alembic::build_depsgraph(job, depsgraph);
+        });
+  }
 
   bool export_ok = false;
   if (as_background_job) {
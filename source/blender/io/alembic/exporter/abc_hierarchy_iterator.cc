@@ -38,6 +38,14 @@ void ABCHierarchyIterator::iterate_and_write()
   update_archive_bounding_box();
 }
 
+void ABCHierarchyIterator::set_depsgraph(Depsgraph *depsgraph)
+{
+  AbstractHierarchyIterator::set_depsgraph(depsgraph);
+  for (AbstractHierarchyWriter *writer : writers_.values()) {
+    static_cast<ABCAbstractWriter *>(writer)->set_depsgraph(depsgraph);
+  }
+}
+
 void ABCHierarchyIterator::update_archive_bounding_box()
 {
   Imath::Box3d bounds;
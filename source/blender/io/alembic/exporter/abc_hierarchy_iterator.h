@@ -43,6 +43,7 @@ class ABCHierarchyIterator : public AbstractHierarchyIterator {
                        const AlembicExportParams &params);
 
   void iterate_and_write() override;
+  void set_depsgraph(Depsgraph *depsgraph) override;
   std::string make_valid_name(const std::string &name) const override;
 
   Alembic::Abc::OObject get_alembic_object(const std::string &export_path) const;
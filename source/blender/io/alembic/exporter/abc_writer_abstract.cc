@@ -83,6 +83,11 @@ const IDProperty *ABCAbstractWriter::get_id_properties(const HierarchyContext &c
   return static_cast<ID *>(object->data)->properties;
 }
 
+void ABCAbstractWriter::set_depsgraph(Depsgraph *depsgraph)
+{
+  args_.depsgraph = depsgraph;
+}
+
 uint32_t ABCAbstractWriter::timesample_index() const
 {
   return timesample_index_;
@@ -18,7 +18,7 @@ namespace blender::io::alembic {
 
 class ABCAbstractWriter : public AbstractHierarchyWriter {
  protected:
-  const ABCWriterConstructorArgs args_;
+  ABCWriterConstructorArgs args_;
 
   bool frame_has_been_written_;
   bool is_animated_;
@@ -45,6 +45,9 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
    * Empty). */
   virtual bool is_supported(const HierarchyContext *context) const;
 
+  /* Called by ABCHierarchyIterator when the next frame is taken from another depsgraph. */
+  void set_depsgraph(Depsgraph *depsgraph);
+
   uint32_t timesample_index() const;
   const Imath::Box3d &bounding_box() const;
 
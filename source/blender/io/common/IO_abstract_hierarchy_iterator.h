@@ -254,6 +254,12 @@ class AbstractHierarchyIterator {
    * previous iteration. */
   void set_export_subset(ExportSubset export_subset);
 
+  /* Use another depsgraph for the next iterate_and_write() calls, for example one that was
+   * evaluated for a different frame by a MultiFrameEvaluator. The depsgraph must be built from the
+   * same scene as the current one, so that the existing writers remain valid. Subclasses that pass
+   * the depsgraph on to their writers should override this to update them as well. */
+  virtual void set_depsgraph(Depsgraph *depsgraph);
+
   /* Convert the given name to something that is valid for the exported file format.
    * This base implementation is a no-op; override in a concrete subclass. */
   virtual std::string make_valid_name(const std::string &name) const;
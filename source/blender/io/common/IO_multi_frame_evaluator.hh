@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+struct Depsgraph;
+
+namespace blender::io {
+
+/**
+ * This code is shared between the Alembic and USD exporters.
+ * Evaluate the frames of an animation export ahead of writing them, so that writing a frame
+ * overlaps with the evaluation of the following frames, while the exporter still writes the
+ * frames one by one, in order.
+ *
+ * The depsgraph evaluations themselves never run concurrently: evaluating several depsgraphs of
+ * the same Main at once is not safe, since they share original data, images and the Python
+ * interpreter used by drivers. Instead, a background thread evaluates the upcoming frames one
+ * after another, each on its own depsgraph from a pool, while the exporter writes the frames that
+ * were already evaluated. Writers only read the evaluated copies of their own depsgraph and
+ * original data, which is not written back to by these evaluations.
+ *
+ * Extra depsgraphs are only created when the frames do not depend on each other (see
+ * #DEG_graph_frames_are_independent). Otherwise, and when only one depsgraph is requested, every
+ * frame is evaluated on the exporter's own depsgraph right before it is written, exactly like a
+ * regular frame change.
+ *
+ * The extra depsgraphs are built in the constructor, which therefore has to run on the main
+ * thread: like the exporter's own depsgraph, building may affect Main original data (see #112534
+ * for details).
+ *
+ * The destructor frees all extra depsgraphs.
+ */
+class MultiFrameEvaluator final {
+ private:
+  Depsgraph *depsgraph_;
+
+  /* Owned depsgraphs, evaluated in addition to #depsgraph_. */
+  Vector<Depsgraph *> extra_depsgraphs_;
+
+ public:
+  /**
+   * \param depsgraph: The depsgraph of the exporter, already built.
+   * \param depsgraphs_num: The number of frames that can be evaluated ahead of the frame that is
+   * being written, plus one.
+   * \param build_fn: Builds the relations of a newly created depsgraph, in the same way as
+   * `depsgraph` was built. Only called when more than one depsgraph is requested, in which case
+   * the constructor must be called from the main thread.
+   */
+  MultiFrameEvaluator(Depsgraph *depsgraph,
+                      int depsgraphs_num,
+                      FunctionRef<void(Depsgraph *depsgraph)> build_fn);
+  ~MultiFrameEvaluator();
+
+  /**
+   * Evaluate the given frames and call `write_fn` for each of them, in order and from the calling
+   * thread, with the depsgraph that contains the evaluated state of that frame. The depsgraph is
+   * only valid during the call. Stops before writing a frame once `should_stop` returns true.
+   *
+   * When done, the frame of the original scene is the last written frame, so that callers can
+   * restore the frame that was current before the export in the same way in both modes.
+   */
+  void foreach_frame(Span<double> frames,
+                     FunctionRef<bool()> should_stop,
+                     FunctionRef<void(double frame, Depsgraph *depsgraph)> write_fn);
+
+  /* Disallow copying. */
+  MultiFrameEvaluator(const MultiFrameEvaluator &) = delete;
+  MultiFrameEvaluator &operator=(const MultiFrameEvaluator &) = delete;
+};
+
+}  // namespace blender::io
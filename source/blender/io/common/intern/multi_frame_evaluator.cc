@@ -0,0 +1,154 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "IO_multi_frame_evaluator.hh"
+
+#include "BKE_scene.hh"
+
+#include "BLI_threads.h"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "DNA_scene_types.h"
+
+#include "CLG_log.h"
+static CLG_LogRef LOG = {"io.common"};
+
+namespace blender::io {
+
+MultiFrameEvaluator::MultiFrameEvaluator(Depsgraph *depsgraph,
+                                         const int depsgraphs_num,
+                                         FunctionRef<void(Depsgraph *depsgraph)> build_fn)
+    : depsgraph_(depsgraph)
+{
+  if (depsgraphs_num <= 1) {
+    return;
+  }
+  if (!DEG_graph_frames_are_independent(depsgraph)) {
+    CLOG_INFO(&LOG, 1, "Scene has simulation caches, evaluating frames sequentially");
+    return;
+  }
+
+  Main *bmain = DEG_get_bmain(depsgraph);
+  Scene *scene = DEG_get_input_scene(depsgraph);
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  const eEvaluationMode mode = DEG_get_mode(depsgraph);
+
+  /* Only build the extra depsgraphs here, evaluating them is left to #foreach_frame, which may
+   * run from the export job thread. */
+  BLI_assert(BLI_thread_is_main());
+  for (int i = 1; i < depsgraphs_num; i++) {
+    Depsgraph *extra_depsgraph = DEG_graph_new(bmain, scene, view_layer, mode);
+    build_fn(extra_depsgraph);
+    extra_depsgraphs_.append(extra_depsgraph);
+  }
+}
+
+MultiFrameEvaluator::~MultiFrameEvaluator()
+{
+  for (Depsgraph *extra_depsgraph : extra_depsgraphs_) {
+    DEG_graph_free(extra_depsgraph);
+  }
+}
+
+void MultiFrameEvaluator::foreach_frame(
+    const Span<double> frames,
+    const FunctionRef<bool()> should_stop,
+    const FunctionRef<void(double frame, Depsgraph *depsgraph)> write_fn)
+{
+  Scene *scene = DEG_get_input_scene(depsgraph_);
+  const auto set_scene_frame = [&](const double frame) {
+    scene->r.cfra = int(frame);
+    scene->r.subframe = float(frame - scene->r.cfra);
+  };
+
+  if (extra_depsgraphs_.is_empty()) {
+    for (const double frame : frames) {
+      if (should_stop()) {
+        break;
+      }
+      set_scene_frame(frame);
+      BKE_scene_graph_update_for_newframe(depsgraph_);
+      write_fn(frame, depsgraph_);
+    }
+    return;
+  }
+
+  Vector<Depsgraph *> depsgraphs = {depsgraph_};
+  depsgraphs.extend(extra_depsgraphs_);
+  const int64_t depsgraphs_num = depsgraphs.size();
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  /* Number of frames evaluated and written so far, protected by the mutex. */
+  int64_t evaluated_num = 0;
+  int64_t written_num = 0;
+  bool stop = false;
+
+  /* Evaluate the frames one after another, frame `i` on depsgraph `i % depsgraphs_num`, once the
+   * frame that used the same depsgraph before has been written. */
+  std::thread eval_thread([&]() {
+    for (const int64_t i : frames.index_range()) {
+      {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&]() { return stop || written_num > i - depsgraphs_num; });
+        if (stop) {
+          return;
+        }
+      }
+      DEG_evaluate_on_framechange(
+          depsgraphs[i % depsgraphs_num], float(frames[i]), DEG_EVALUATE_SYNC_WRITEBACK_NO);
+      {
+        std::lock_guard lock(mutex);
+        evaluated_num = i + 1;
+      }
+      condition.notify_all();
+    }
+  });
+
+  const auto stop_eval_thread = [&]() {
+    {
+      std::lock_guard lock(mutex);
+      stop = true;
+    }
+    condition.notify_all();
+    eval_thread.join();
+  };
+
+  int64_t last_written_index = -1;
+  try {
+    for (const int64_t i : frames.index_range()) {
+      if (should_stop()) {
+        break;
+      }
+      {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&]() { return evaluated_num > i; });
+      }
+      write_fn(frames[i], depsgraphs[i % depsgraphs_num]);
+      last_written_index = i;
+      {
+        std::lock_guard lock(mutex);
+        written_num = i + 1;
+      }
+      condition.notify_all();
+    }
+  }
+  catch (...) {
+    stop_eval_thread();
+    throw;
+  }
+  stop_eval_thread();
+
+  if (last_written_index != -1) {
+    set_scene_frame(frames[last_written_index]);
+  }
+}
+
+}  // namespace blender::io
@@ -3,7 +3,10 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <fmt/core.h>
+#include <memory>
+#include <optional>
 
+#include "IO_multi_frame_evaluator.hh"
 #include "IO_subdiv_disabler.hh"
 #include "usd.hh"
 #include "usd_hierarchy_iterator.hh"
@@ -72,6 +75,9 @@ struct ExportJobData {
   char usdz_filepath[FILE_MAX] = {};
   USDExportParams params = {};
 
+  /* Evaluates the frames of animation exports, built along with #depsgraph on the main thread. */
+  std::unique_ptr<MultiFrameEvaluator> frame_evaluator;
+
   bool export_ok = false;
   timeit::TimePoint start_time = {};
 
@@ -386,9 +392,33 @@ std::string cache_image_color(const float color[4])
   return file_path;
 }
 
+/* Construct the depsgraph for exporting. Returns false when the collection to export is not
+ * found. */
+static bool build_depsgraph(Main *bmain, const USDExportParams &params, Depsgraph *depsgraph)
+{
+  if (params.collection[0]) {
+    Collection *collection = reinterpret_cast<Collection *>(
+        BKE_libblock_find_name(bmain, ID_GR, params.collection));
+    if (!collection) {
+      return false;
+    }
+
+    DEG_graph_build_from_collection(depsgraph, collection);
+  }
+  else if (params.visible_objects_only) {
+    DEG_graph_build_from_view_layer(depsgraph);
+  }
+  else {
+    DEG_graph_build_for_all_objects(depsgraph);
+  }
+
+  return true;
+}
+
 pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
                                     Depsgraph *depsgraph,
-                                    const char *filepath)
+                                    const char *filepath,
+                                    MultiFrameEvaluator *frame_evaluator)
 {
   pxr::UsdStageRefPtr usd_stage = pxr::UsdStage::CreateNew(filepath);
   if (!usd_stage) {
@@ -453,25 +483,36 @@ pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
   worker_status->do_update = true;
 
   if (params.export_animation) {
-    /* Writing the animated frames is not 100% of the work, here it's assumed to be 75% of it. */
-    float progress_per_frame = 0.75f / std::max(1, (scene->r.efra - scene->r.sfra + 1));
+    /* A single depsgraph never builds extra depsgraphs, so it is safe to create from any
+     * thread. */
+    std::optional<MultiFrameEvaluator> sequential_evaluator;
+    if (frame_evaluator == nullptr) {
+      sequential_evaluator.emplace(depsgraph, 1, [](Depsgraph * /*depsgraph*/) {});
+      frame_evaluator = &*sequential_evaluator;
+    }
 
+    Vector<double> frames;
     for (float frame = scene->r.sfra; frame <= scene->r.efra; frame++) {
-      if (G.is_break || worker_status->stop) {
-        break;
-      }
+      frames.append(frame);
+    }
 
-      /* Update the scene for the next frame to render. */
-      scene->r.cfra = int(frame);
-      scene->r.subframe = frame - scene->r.cfra;
-      BKE_scene_graph_update_for_newframe(depsgraph);
+    /* Writing the animated frames is not 100% of the work, here it's assumed to be 75% of it. */
+    float progress_per_frame = 0.75f / std::max(1, (scene->r.efra - scene->r.sfra + 1));
 
-      iter.set_export_frame(frame);
-      iter.iterate_and_write();
+    frame_evaluator->foreach_frame(
+        frames,
+        [&]() { return G.is_break || worker_status->stop; },
+        [&](const double frame, Depsgraph *frame_depsgraph) {
+          iter.set_depsgraph(frame_depsgraph);
+          iter.set_export_frame(float(frame));
+          iter.iterate_and_write();
 
-      worker_status->progress += progress_per_frame;
-      worker_status->do_update = true;
-    }
+          worker_status->progress += progress_per_frame;
+          worker_status->do_update = true;
+        });
+
+    /* The extra depsgraphs are freed by the owner of the frame evaluator. */
+    iter.set_depsgraph(depsgraph);
   }
   else {
     /* If we're not animating, a single iteration over all objects is enough. */
@@ -554,7 +595,7 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
   data->params.worker_status = worker_status;
 
   pxr::UsdStageRefPtr usd_stage = export_to_stage(
-      data->params, data->depsgraph, data->unarchived_filepath);
+      data->params, data->depsgraph, data->unarchived_filepath, data->frame_evaluator.get());
   if (!usd_stage) {
     /* This happens when the USD JSON files cannot be found. When that happens,
      * the USD library doesn't know it has the functionality to write USDA and
@@ -595,6 +636,7 @@ static void export_endjob(void *customdata)
 {
   ExportJobData *data = static_cast<ExportJobData *>(customdata);
 
+  data->frame_evaluator.reset();
   DEG_graph_free(data->depsgraph);
 
   if (data->targets_usdz()) {
@@ -683,24 +725,22 @@ bool USD_export(const bContext *C,
    *
    * Has to be done from main thread currently, as it may affect Main original data (e.g. when
    * doing deferred update of the view-layers, see #112534 for details). */
-  if (job->params.collection[0]) {
-    Collection *collection = reinterpret_cast<Collection *>(
-        BKE_libblock_find_name(job->bmain, ID_GR, job->params.collection));
-    if (!collection) {
-      BKE_reportf(job->params.worker_status->reports,
-                  RPT_ERROR,
-                  "USD Export: Unable to find collection '%s'",
-                  job->params.collection);
-      return false;
-    }
-
-    DEG_graph_build_from_collection(job->depsgraph, collection);
-  }
-  else if (job->params.visible_objects_only) {
-    DEG_graph_build_from_view_layer(job->depsgraph);
+  if (!build_depsgraph(job->bmain, job->params, job->depsgraph)) {
+    BKE_reportf(job->params.worker_status->reports,
+                RPT_ERROR,
+                "USD Export: Unable to find collection '%s'",
+                job->params.collection);
+    return false;
   }
-  else {
-    DEG_graph_build_for_all_objects(job->depsgraph);
+  if (params->export_animation) {
+    /* The extra depsgraphs for parallel frame evaluation are built here for the same reason.
+     * Skeleton and shape key post-processing looks up the evaluated objects of the exported
+     * meshes in a single depsgraph, so those exports always evaluate frames sequentially. */
+    const bool use_skel = params->export_shapekeys || params->export_armatures;
+    job->frame_evaluator = std::make_unique<blender::io::MultiFrameEvaluator>(
+        job->depsgraph, use_skel ? 1 : params->parallel_frames, [&](Depsgraph *depsgraph) {
+          blender::io::usd::build_depsgraph(job->bmain, job->params, depsgraph);
+        });
   }
 
   bool export_ok = false;
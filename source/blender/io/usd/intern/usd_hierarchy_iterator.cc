@@ -94,6 +94,14 @@ void USDHierarchyIterator::process_usd_skel() const
   create_skel_roots(stage_, params_);
 }
 
+void USDHierarchyIterator::set_depsgraph(Depsgraph *depsgraph)
+{
+  AbstractHierarchyIterator::set_depsgraph(depsgraph);
+  for (AbstractHierarchyWriter *writer : writers_.values()) {
+    static_cast<USDAbstractWriter *>(writer)->set_depsgraph(depsgraph);
+  }
+}
+
 void USDHierarchyIterator::set_export_frame(float frame_nr)
 {
   /* The USD stage is already set up to have FPS time-codes per frame. */
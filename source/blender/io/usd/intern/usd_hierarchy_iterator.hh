@@ -40,6 +40,7 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
                        const USDExportParams &params);
 
   void set_export_frame(float frame_nr);
+  void set_depsgraph(Depsgraph *depsgraph) override;
 
   std::string make_valid_name(const std::string &name) const override;
 
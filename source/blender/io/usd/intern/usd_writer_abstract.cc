@@ -189,6 +189,11 @@ const pxr::SdfPath &USDAbstractWriter::usd_path() const
   return usd_export_context_.usd_path;
 }
 
+void USDAbstractWriter::set_depsgraph(Depsgraph *depsgraph)
+{
+  usd_export_context_.depsgraph = depsgraph;
+}
+
 pxr::SdfPath USDAbstractWriter::get_material_library_path() const
 {
   static std::string material_library_path("/_materials");
@@ -32,7 +32,7 @@ using blender::io::HierarchyContext;
 
 class USDAbstractWriter : public AbstractHierarchyWriter {
  protected:
-  const USDExporterContext usd_export_context_;
+  USDExporterContext usd_export_context_;
   pxr::UsdUtilsSparseValueWriter usd_value_writer_;
 
   bool frame_has_been_written_;
@@ -56,6 +56,9 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
 
   const pxr::SdfPath &usd_path() const;
 
+  /** Called by the hierarchy iterator when the next frame is taken from another depsgraph. */
+  void set_depsgraph(Depsgraph *depsgraph);
+
   /** Get the wmJobWorkerStatus-provided `reports` list pointer, to use with the BKE_report API. */
   ReportList *reports() const
   {
@@ -156,6 +156,11 @@ struct USDExportParams {
 
   eSubdivExportMode export_subdiv = USD_SUBDIV_BEST_MATCH;
   enum eEvaluationMode evaluation_mode = DAG_EVAL_VIEWPORT;
+  /**
+   * Number of animation frames to keep evaluated at the same time, each on its own depsgraph, so
+   * that upcoming frames are evaluated while a frame is written.
+   */
+  int parallel_frames = 1;
 
   bool generate_preview_surface = true;
   bool generate_materialx_network = true;
@@ -12,11 +12,21 @@
 
 struct Depsgraph;
 
+namespace blender::io {
+class MultiFrameEvaluator;
+}
+
 namespace blender::io::usd {
 
+/**
+ * \param frame_evaluator: Evaluates the frames of animation exports. It has to be created on the
+ * main thread, see #MultiFrameEvaluator. When null, frames are evaluated sequentially on
+ * `depsgraph`.
+ */
 pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
                                     Depsgraph *depsgraph,
-                                    const char *filepath);
+                                    const char *filepath,
+                                    MultiFrameEvaluator *frame_evaluator = nullptr);
 
 std::string image_cache_file_path();
 std::string get_image_cache_file(const std::string &file_name, bool mkdir = true);
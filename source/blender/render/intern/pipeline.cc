@@ -28,6 +28,7 @@
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_path_utils.hh"
 #include "BLI_rect.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
@@ -1368,6 +1369,10 @@ static void do_render_compositor(Render *re)
           /* If we have consistent depsgraph now would be a time to update them. */
         }
 
+        /* Only profile the compositor if requested from the command line. */
+        const bool use_profiler = G.profile_compositor_filepath[0] != '\0';
+        blender::compositor::Profiler compositor_profiler;
+
         blender::compositor::RenderContext compositor_render_context;
         LISTBASE_FOREACH (RenderView *, rv, &re->result->views) {
           COM_execute(re,
@@ -1376,12 +1381,21 @@ static void do_render_compositor(Render *re)
                       ntree,
                       rv->name,
                       &compositor_render_context,
-                      nullptr,
+                      use_profiler ? &compositor_profiler : nullptr,
                       blender::compositor::OutputTypes::Composite |
                           blender::compositor::OutputTypes::FileOutput);
         }
         compositor_render_context.save_file_outputs(re->pipeline_scene_eval);
 
+        if (use_profiler) {
+          char filepath[FILE_MAX];
+          STRNCPY(filepath, G.profile_compositor_filepath);
+          BLI_path_frame(filepath, sizeof(filepath), re->r.cfra, 0);
+          if (!compositor_profiler.write_trace(filepath)) {
+            fprintf(stderr, "Error: could not write compositor profile to '%s'\n", filepath);
+          }
+        }
+
         ntree->runtime->stats_draw = nullptr;
         ntree->runtime->test_break = nullptr;
         ntree->runtime->progress = nullptr;
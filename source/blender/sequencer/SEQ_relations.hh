@@ -9,6 +9,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 
 struct ListBase;
 struct Main;
@@ -56,6 +57,24 @@ void SEQ_relations_check_uids_unique_and_report(const Scene *scene);
 void SEQ_relations_session_uid_generate(Strip *sequence);
 
 void SEQ_cache_cleanup(Scene *scene);
+
+#define SEQ_DISK_CACHE_READ_TIME_BUCKETS 8
+
+struct SeqDiskCacheStatistics {
+  int64_t hits;
+  int64_t misses;
+  /**
+   * Number of hits per read time, bucket `i` counts reads that took less than `2^i` milliseconds
+   * and more than the previous bucket, the last bucket counts all slower reads.
+   */
+  int64_t read_time_histogram[SEQ_DISK_CACHE_READ_TIME_BUCKETS];
+};
+
+/**
+ * Get statistics of reads from the disk cache of the scene.
+ * Returns false if the scene has no disk cache.
+ */
+bool SEQ_disk_cache_statistics_get(Scene *scene, SeqDiskCacheStatistics *r_statistics);
 void SEQ_cache_iterate(
     Scene *scene,
     void *userdata,
@@ -8,8 +8,17 @@
 
 #include <cstddef>
 #include <ctime>
+#include <fcntl.h>
 #include <memory.h>
 
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -24,13 +33,19 @@
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
+#include "SEQ_relations.hh"
 #include "SEQ_render.hh"
 #include "SEQ_time.hh"
 
@@ -45,8 +60,12 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * ZLIB compression with user definable level can be used to compress image data(per image)
- * Images are written in order in which they are rendered.
+ * ZSTD compression with user definable level can be used to compress image data(per image).
+ * Bytes of float images are split into planes before compression, which is lossless and makes
+ * the slowly varying sign and exponent bytes contiguous, so they compress much better.
+ * Images are written asynchronously by a writer thread in order in which they are rendered.
+ * Images waiting to be written can still be read from the write queue.
+ * Images are read through memory-mapped files.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
@@ -58,11 +77,22 @@
  * `<cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf`. */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 2
+#define DCACHE_CURRENT_VERSION 3
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
+/* Maximum number of images waiting to be written, limits the memory used by the write queue. */
+#define DCACHE_WRITE_QUEUE_MAX 16
+
+enum eDiskCacheCompression {
+  DCACHE_COMPRESSION_NONE = 0,
+  DCACHE_COMPRESSION_ZSTD = 1,
+  /* Bytes of float pixels are split into planes before ZSTD compression. */
+  DCACHE_COMPRESSION_ZSTD_FLOAT_PLANES = 2,
+};
 
 struct DiskCacheHeaderEntry {
   uchar encoding;
+  /* #eDiskCacheCompression. */
+  uchar compression;
   uint64_t frameno;
   uint64_t size_compressed;
   uint64_t size_raw;
@@ -74,12 +104,30 @@ struct DiskCacheHeader {
   DiskCacheHeaderEntry entry[DCACHE_IMAGES_PER_FILE];
 };
 
+/* An image waiting to be written by the writer thread. */
+struct DiskCacheWriteRequest {
+  char filepath[FILE_MAX];
+  uint64_t frameno;
+  ImBuf *ibuf;
+};
+
 struct SeqDiskCache {
-  Main *bmain;
-  int64_t timestamp;
-  ListBase files;
-  ThreadMutex read_write_mutex;
-  size_t size_total;
+  Main *bmain = nullptr;
+  int64_t timestamp = 0;
+  ListBase files = {};
+  ThreadMutex read_write_mutex = {};
+  size_t size_total = 0;
+
+  /* Images are written by a writer thread, see #seq_disk_cache_writer_thread. */
+  ListBase writer_thread = {};
+  ThreadMutex write_queue_mutex = {};
+  ThreadCondition write_queue_cond = {};
+  /* Requests in order in which they were made, the first one is being written. */
+  blender::Vector<DiskCacheWriteRequest> write_queue;
+  bool stop_writer = false;
+
+  /* Protected by #read_write_mutex. */
+  SeqDiskCacheStatistics statistics = {};
 };
 
 struct DiskCacheFile {
@@ -217,7 +265,7 @@ static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *
   MEM_freeN(file);
 }
 
-bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
+static bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
   while (disk_cache->size_total > seq_disk_cache_size_limit()) {
@@ -395,6 +443,16 @@ static void seq_disk_cache_delete_invalid_files(SeqDiskCache *disk_cache,
   }
 }
 
+/* Wait for all queued images to be written. */
+static void seq_disk_cache_flush_writes(SeqDiskCache *disk_cache)
+{
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  while (!disk_cache->write_queue.is_empty()) {
+    BLI_condition_wait(&disk_cache->write_queue_cond, &disk_cache->write_queue_mutex);
+  }
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+}
+
 void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
                                Scene *scene,
                                Strip *strip,
@@ -404,6 +462,9 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Pending writes might otherwise recreate invalidated files. */
+  seq_disk_cache_flush_writes(disk_cache);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, strip_changed) - DCACHE_IMAGES_PER_FILE;
@@ -414,53 +475,133 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+static void *seq_disk_cache_ibuf_data(ImBuf *ibuf)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
+  return (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
+                                               (void *)ibuf->float_buffer.data;
+}
 
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
-  }
+/* Split the bytes of the given floats into 4 planes, such that the i-th plane stores the i-th
+ * byte of all floats. */
+static void float_bytes_to_planes(const uchar *src, uchar *dst, const size_t floats_num)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(floats_num), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          for (const int64_t plane : blender::IndexRange(4)) {
+            dst[plane * floats_num + i] = src[i * 4 + plane];
+          }
+        }
+      });
+}
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+/* Inverse of #float_bytes_to_planes. */
+static void float_planes_to_bytes(const uchar *src, uchar *dst, const size_t floats_num)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(floats_num), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          for (const int64_t plane : blender::IndexRange(4)) {
+            dst[i * 4 + plane] = src[plane * floats_num + i];
+          }
+        }
+      });
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+/* Compress the image data into the returned buffer and set the compression of the header entry
+ * accordingly. Returns an empty buffer if no compression is wanted or compression failed, in
+ * which case the image data is written as is. */
+static blender::Vector<uchar> compress_imbuf(ImBuf *ibuf,
+                                             const int level,
+                                             DiskCacheHeaderEntry *header_entry)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
-    return 0;
+  header_entry->compression = DCACHE_COMPRESSION_NONE;
+  if (level == 0) {
+    return {};
   }
 
-  /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
+  const uchar *data = static_cast<const uchar *>(seq_disk_cache_ibuf_data(ibuf));
+  const size_t size_raw = header_entry->size_raw;
+
+  /* Split bytes of float images into planes, see design notes. */
+  blender::Array<uchar> planes;
+  if (ibuf->float_buffer.data != nullptr) {
+    planes.reinitialize(size_raw);
+    float_bytes_to_planes(data, planes.data(), size_raw / sizeof(float));
+    data = planes.data();
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
+  blender::Vector<uchar> compressed;
+  compressed.resize(ZSTD_compressBound(size_raw));
+  const size_t size_compressed = ZSTD_compress(
+      compressed.data(), compressed.size(), data, size_raw, level);
+  if (ZSTD_isError(size_compressed)) {
+    return {};
+  }
+  compressed.resize(size_compressed);
+
+  header_entry->compression = planes.is_empty() ? DCACHE_COMPRESSION_ZSTD :
+                                                  DCACHE_COMPRESSION_ZSTD_FLOAT_PLANES;
+  return compressed;
 }
 
-static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
+static size_t write_imbuf_to_file(ImBuf *ibuf,
+                                  blender::Span<uchar> compressed_data,
+                                  FILE *file,
+                                  DiskCacheHeaderEntry *header_entry)
 {
-  BLI_fseek(file, 0LL, SEEK_SET);
-  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
-  if (num_items_read < 1) {
-    BLI_assert_msg(0, "unable to read disk cache header");
-    perror("unable to read disk cache header");
+  BLI_fseek(file, header_entry->offset, SEEK_SET);
+  if (header_entry->compression != DCACHE_COMPRESSION_NONE) {
+    return fwrite(compressed_data.data(), 1, compressed_data.size(), file);
+  }
+  return fwrite(seq_disk_cache_ibuf_data(ibuf), 1, header_entry->size_raw, file);
+}
+
+/* Read the image data from the memory-mapped file, decompressing directly from the mapped memory
+ * into the image buffer. */
+static bool read_file_to_imbuf(ImBuf *ibuf,
+                               BLI_mmap_file *mmap_file,
+                               const DiskCacheHeaderEntry *header_entry)
+{
+  void *data = seq_disk_cache_ibuf_data(ibuf);
+  const size_t file_length = BLI_mmap_get_length(mmap_file);
+  if (header_entry->offset + header_entry->size_compressed > file_length) {
+    return false;
+  }
+
+  if (header_entry->compression == DCACHE_COMPRESSION_NONE) {
+    if (header_entry->size_compressed != header_entry->size_raw) {
+      return false;
+    }
+    return BLI_mmap_read(mmap_file, data, header_entry->offset, header_entry->size_raw);
+  }
+
+  /* IO errors replace the mapped memory with zeros, which fails decompression. */
+  const uchar *compressed_data = static_cast<const uchar *>(BLI_mmap_get_pointer(mmap_file)) +
+                                 header_entry->offset;
+
+  blender::Array<uchar> planes;
+  void *decompress_data = data;
+  if (header_entry->compression == DCACHE_COMPRESSION_ZSTD_FLOAT_PLANES) {
+    planes.reinitialize(header_entry->size_raw);
+    decompress_data = planes.data();
+  }
+
+  const size_t size_decompressed = ZSTD_decompress(
+      decompress_data, header_entry->size_raw, compressed_data, header_entry->size_compressed);
+  if (ZSTD_isError(size_decompressed) || size_decompressed != header_entry->size_raw) {
     return false;
   }
 
+  if (!planes.is_empty()) {
+    float_planes_to_bytes(planes.data(), static_cast<uchar *>(data), planes.size() / 4);
+  }
+
+  return true;
+}
+
+static void seq_disk_cache_header_endian_switch(DiskCacheHeader *header)
+{
   for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
     if ((ENDIAN_ORDER == B_ENDIAN) && header->entry[i].encoding == 0) {
       BLI_endian_switch_uint64(&header->entry[i].frameno);
@@ -469,7 +610,29 @@ static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
       BLI_endian_switch_uint64(&header->entry[i].size_raw);
     }
   }
+}
+
+static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
+{
+  BLI_fseek(file, 0LL, SEEK_SET);
+  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
+  if (num_items_read < 1) {
+    BLI_assert_msg(0, "unable to read disk cache header");
+    perror("unable to read disk cache header");
+    return false;
+  }
+
+  seq_disk_cache_header_endian_switch(header);
+  return true;
+}
+
+static bool seq_disk_cache_read_header_mmap(BLI_mmap_file *mmap_file, DiskCacheHeader *header)
+{
+  if (!BLI_mmap_read(mmap_file, header, 0, sizeof(*header))) {
+    return false;
+  }
 
+  seq_disk_cache_header_endian_switch(header);
   return true;
 }
 
@@ -479,7 +642,7 @@ static size_t seq_disk_cache_write_header(FILE *file, const DiskCacheHeader *hea
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(const SeqCacheKey *key,
+static int seq_disk_cache_add_header_entry(const uint64_t frameno,
                                            ImBuf *ibuf,
                                            DiskCacheHeader *header)
 {
@@ -514,7 +677,7 @@ static int seq_disk_cache_add_header_entry(const SeqCacheKey *key,
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frameno;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -542,13 +705,21 @@ static int seq_disk_cache_get_header_entry(const SeqCacheKey *key, const DiskCac
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static void seq_disk_cache_write_request(SeqDiskCache *disk_cache,
+                                        const DiskCacheWriteRequest &request)
 {
-  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  ImBuf *ibuf = request.ibuf;
 
-  char filepath[FILE_MAX];
+  /* Compress before locking, so that reads are not blocked by compression. */
+  DiskCacheHeaderEntry entry = {};
+  entry.size_raw = int64_t(ibuf->x) * ibuf->y * ibuf->channels *
+                   (ibuf->byte_buffer.data ? 1 : 4);
+  const blender::Vector<uchar> compressed_data = compress_imbuf(
+      ibuf, seq_disk_cache_compression_level(), &entry);
 
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+
+  const char *filepath = request.filepath;
   BLI_file_ensure_parent_dir_exists(filepath);
 
   /* Touch the file. */
@@ -557,7 +728,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     file = BLI_fopen(filepath, "wb+");
     if (!file) {
       BLI_mutex_unlock(&disk_cache->read_write_mutex);
-      return false;
+      return;
     }
     seq_disk_cache_add_file_to_list(disk_cache, filepath);
   }
@@ -571,12 +742,13 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     fclose(file);
     seq_disk_cache_delete_file(disk_cache, cache_file);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return false;
+    return;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(request.frameno, ibuf, &header);
+  header.entry[entry_index].compression = entry.compression;
 
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+  size_t bytes_written = write_imbuf_to_file(
+      ibuf, compressed_data, file, &header.entry[entry_index]);
 
   if (bytes_written != 0) {
     /* Last step is writing header, as image data can be overwritten,
@@ -585,102 +757,221 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     header.entry[entry_index].size_compressed = bytes_written;
     seq_disk_cache_write_header(file, &header);
     seq_disk_cache_update_file(disk_cache, filepath);
-    fclose(file);
-
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return true;
   }
+  fclose(file);
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
-  return false;
 }
 
-ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
+static void *seq_disk_cache_writer_thread(void *data)
 {
-  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(data);
 
-  char filepath[FILE_MAX];
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  while (true) {
+    while (disk_cache->write_queue.is_empty() && !disk_cache->stop_writer) {
+      BLI_condition_wait(&disk_cache->write_queue_cond, &disk_cache->write_queue_mutex);
+    }
+    /* Pending writes are finished before stopping. */
+    if (disk_cache->write_queue.is_empty()) {
+      break;
+    }
+
+    /* Keep the request in the queue while writing, so the image can still be read. */
+    const DiskCacheWriteRequest request = disk_cache->write_queue.first();
+    BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+    seq_disk_cache_write_request(disk_cache, request);
+    seq_disk_cache_enforce_limits(disk_cache);
+
+    BLI_mutex_lock(&disk_cache->write_queue_mutex);
+    disk_cache->write_queue.remove(0);
+    IMB_freeImBuf(request.ibuf);
+    BLI_condition_notify_all(&disk_cache->write_queue_cond);
+  }
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+  return nullptr;
+}
+
+bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  DiskCacheWriteRequest request;
+  seq_disk_cache_get_file_path(disk_cache, key, request.filepath, sizeof(request.filepath));
+  request.frameno = key->frame_index;
+  request.ibuf = ibuf;
+
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  while (disk_cache->write_queue.size() >= DCACHE_WRITE_QUEUE_MAX) {
+    BLI_condition_wait(&disk_cache->write_queue_cond, &disk_cache->write_queue_mutex);
+  }
+  IMB_refImBuf(ibuf);
+  disk_cache->write_queue.append(request);
+  BLI_condition_notify_all(&disk_cache->write_queue_cond);
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+  return true;
+}
+
+/* Return the image of a request in the write queue matching the given file and frame. */
+static ImBuf *seq_disk_cache_read_write_queue(SeqDiskCache *disk_cache,
+                                              const char *filepath,
+                                              const uint64_t frameno)
+{
+  ImBuf *ibuf = nullptr;
+
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  for (const DiskCacheWriteRequest &request : disk_cache->write_queue) {
+    if (request.frameno == frameno && STREQ(request.filepath, filepath)) {
+      ibuf = request.ibuf;
+      IMB_refImBuf(ibuf);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+  return ibuf;
+}
+
+/* Expects #SeqDiskCache.read_write_mutex to be locked. */
+static void seq_disk_cache_add_read_statistics(SeqDiskCache *disk_cache,
+                                               const bool is_hit,
+                                               const double start_time)
+{
+  SeqDiskCacheStatistics &statistics = disk_cache->statistics;
+  if (!is_hit) {
+    statistics.misses++;
+    return;
+  }
+
+  statistics.hits++;
+  const double read_time_ms = (BLI_time_now_seconds() - start_time) * 1000.0;
+  int bucket = 0;
+  while (bucket < SEQ_DISK_CACHE_READ_TIME_BUCKETS - 1 && read_time_ms >= double(1 << bucket)) {
+    bucket++;
+  }
+  statistics.read_time_histogram[bucket]++;
+}
+
+static ImBuf *seq_disk_cache_read_file_ex(SeqDiskCache *disk_cache,
+                                          SeqCacheKey *key,
+                                          const char *filepath)
+{
   DiskCacheHeader header;
 
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
-  BLI_file_ensure_parent_dir_exists(filepath);
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return nullptr;
+  }
 
-  FILE *file = BLI_fopen(filepath, "rb");
-  if (!file) {
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (mmap_file == nullptr) {
+    close(file);
     return nullptr;
   }
 
-  if (!seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+  if (!seq_disk_cache_read_header_mmap(mmap_file, &header)) {
+    BLI_mmap_free(mmap_file);
+    close(file);
     return nullptr;
   }
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
   if (entry_index < 0) {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    BLI_mmap_free(mmap_file);
+    close(file);
     return nullptr;
   }
 
   ImBuf *ibuf;
   uint64_t size_char = uint64_t(key->context.rectx) * key->context.recty * 4;
   uint64_t size_float = uint64_t(key->context.rectx) * key->context.recty * 16;
-  size_t expected_size;
 
   if (header.entry[entry_index].size_raw == size_char) {
-    expected_size = size_char;
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rect | IB_uninitialized_pixels);
     IMB_colormanagement_assign_byte_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else if (header.entry[entry_index].size_raw == size_float) {
-    expected_size = size_float;
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rectfloat | IB_uninitialized_pixels);
     IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    BLI_mmap_free(mmap_file);
+    close(file);
     return nullptr;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  const bool is_read = read_file_to_imbuf(ibuf, mmap_file, &header.entry[entry_index]);
+  BLI_mmap_free(mmap_file);
+  close(file);
 
   /* Sanity check. */
-  if (bytes_read != expected_size) {
-    fclose(file);
+  if (!is_read) {
     IMB_freeImBuf(ibuf);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
   BLI_file_touch(filepath);
   seq_disk_cache_update_file(disk_cache, filepath);
-  fclose(file);
 
+  return ibuf;
+}
+
+ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
+{
+  const double start_time = BLI_time_now_seconds();
+
+  char filepath[FILE_MAX];
+  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
+
+  ImBuf *ibuf = seq_disk_cache_read_write_queue(disk_cache, filepath, key->frame_index);
+
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  if (ibuf == nullptr) {
+    ibuf = seq_disk_cache_read_file_ex(disk_cache, key, filepath);
+  }
+  seq_disk_cache_add_read_statistics(disk_cache, ibuf != nullptr, start_time);
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
+
   return ibuf;
 }
 
+void seq_disk_cache_statistics_get(SeqDiskCache *disk_cache, SeqDiskCacheStatistics *r_statistics)
+{
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  *r_statistics = disk_cache->statistics;
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+}
+
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 {
-  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(
-      MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
+  SeqDiskCache *disk_cache = MEM_new<SeqDiskCache>("SeqDiskCache");
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
+  BLI_mutex_init(&disk_cache->write_queue_mutex);
+  BLI_condition_init(&disk_cache->write_queue_cond);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
+  BLI_threadpool_init(&disk_cache->writer_thread, seq_disk_cache_writer_thread, 1);
+  BLI_threadpool_insert(&disk_cache->writer_thread, disk_cache);
   BLI_mutex_unlock(&cache_create_lock);
   return disk_cache;
 }
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  disk_cache->stop_writer = true;
+  BLI_condition_notify_all(&disk_cache->write_queue_cond);
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+  BLI_threadpool_end(&disk_cache->writer_thread);
+
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
-  MEM_freeN(disk_cache);
+  BLI_mutex_end(&disk_cache->write_queue_mutex);
+  BLI_condition_end(&disk_cache->write_queue_cond);
+  MEM_delete(disk_cache);
 }
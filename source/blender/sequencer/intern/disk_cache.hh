@@ -17,14 +17,19 @@ struct Main;
 struct Scene;
 struct SeqCacheKey;
 struct SeqDiskCache;
+struct SeqDiskCacheStatistics;
 struct Strip;
 
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene);
 void seq_disk_cache_free(SeqDiskCache *disk_cache);
 bool seq_disk_cache_is_enabled(Main *bmain);
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key);
+/**
+ * Queue the image to be written asynchronously, the image is referenced until it is written.
+ * Size limits of the cache are enforced after writing.
+ */
 bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf);
-bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache);
+void seq_disk_cache_statistics_get(SeqDiskCache *disk_cache, SeqDiskCacheStatistics *r_statistics);
 void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
                                Scene *scene,
                                Strip *strip,
@@ -817,15 +817,25 @@ void seq_cache_put(
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == nullptr) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
       seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
     }
   }
 }
 
+bool SEQ_disk_cache_statistics_get(Scene *scene, SeqDiskCacheStatistics *r_statistics)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache || !cache->disk_cache) {
+    return false;
+  }
+
+  seq_disk_cache_statistics_get(cache->disk_cache, r_statistics);
+  return true;
+}
+
 void SEQ_cache_iterate(
     Scene *scene,
     void *userdata,
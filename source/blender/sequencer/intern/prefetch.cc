@@ -10,6 +10,8 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <optional>
 
 #include "MEM_guardedalloc.h"
 
@@ -18,8 +20,10 @@
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
 #include "IMB_imbuf.hh"
@@ -47,6 +51,34 @@
 #include "prefetch.hh"
 #include "render.hh"
 
+struct PrefetchJob;
+
+/* A worker of the prefetch job, which renders frames on its own thread using its own depsgraph,
+ * such that several frames can be rendered concurrently. */
+struct PrefetchWorker {
+  PrefetchJob *pfjob = nullptr;
+
+  Depsgraph *depsgraph = nullptr;
+  Scene *scene_eval = nullptr;
+
+  /* Render context of the evaluated scene. */
+  SeqRenderData context_cpy = {};
+
+  /* The frame that is currently being prefetched by this worker. */
+  int timeline_frame = 0;
+  bool is_rendering = false;
+  bool is_waiting = false;
+};
+
+/* A frame that was rendered by a worker, but not yet put in the cache, see
+ * #seq_prefetch_put_rendered_frames. */
+struct PrefetchRenderedFrame {
+  int timeline_frame;
+  /* The original strip that the final image of the frame is cached for. */
+  Strip *strip;
+  ImBuf *ibuf;
+};
+
 struct PrefetchJob {
   PrefetchJob *next = nullptr;
   PrefetchJob *prev = nullptr;
@@ -54,17 +86,25 @@ struct PrefetchJob {
   Main *bmain = nullptr;
   Main *bmain_eval = nullptr;
   Scene *scene = nullptr;
-  Scene *scene_eval = nullptr;
-  Depsgraph *depsgraph = nullptr;
 
+  /* Protects the prefetch area and the state of the workers. */
   ThreadMutex prefetch_suspend_mutex = {};
   ThreadCondition prefetch_suspend_cond = {};
+  /* Serializes putting rendered frames in the cache, such that they are put in order. */
+  ThreadMutex cache_put_mutex = {};
+  /* Serializes the evaluation of the depsgraphs of the workers. They all share #bmain_eval, which
+   * is not safe to evaluate from multiple depsgraphs at once. */
+  ThreadMutex depsgraph_eval_mutex = {};
 
   ListBase threads = {};
+  blender::Array<PrefetchWorker> workers;
+  int num_workers_running = 0;
+
+  /* Frames that were rendered out of order, waiting for the frames before them to be rendered. */
+  blender::Vector<PrefetchRenderedFrame> rendered_frames;
 
   /* context */
   SeqRenderData context = {};
-  SeqRenderData context_cpy = {};
   ListBase *seqbasep = nullptr;
   ListBase *seqbasep_cpy = nullptr;
 
@@ -81,6 +121,23 @@ struct PrefetchJob {
   bool is_scrubbing = false;
 };
 
+/* Rendering of a single frame is already multi-threaded, so only use a few workers, leaving
+ * threads available for the rendering of each frame and limiting the memory used by the evaluated
+ * copies of the scene of each worker. */
+static int seq_prefetch_workers_num()
+{
+  return std::clamp(BLI_system_thread_count() / 8, 1, 8);
+}
+
+/* With more than one worker, frames are rendered concurrently, so workers can't put the images
+ * of the frames in the cache while rendering, since the cache links its entries in the order they
+ * are put. Instead, they skip the cache and the final images are put in the cache in order once
+ * rendered, see #seq_prefetch_put_rendered_frames. */
+static bool seq_prefetch_use_concurrent_workers(const PrefetchJob *pfjob)
+{
+  return pfjob->workers.size() > 1;
+}
+
 static PrefetchJob *seq_prefetch_job_get(Scene *scene)
 {
   if (scene && scene->ed) {
@@ -168,9 +225,9 @@ static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
   return pfjob->cfra + pfjob->num_frames_prefetched;
 }
-static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchJob *pfjob)
+static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchWorker *worker)
 {
-  return BKE_animsys_eval_context_construct(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  return BKE_animsys_eval_context_construct(worker->depsgraph, worker->timeline_frame);
 }
 
 void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
@@ -181,37 +238,42 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
   *r_end = seq_prefetch_cfra(pfjob);
 }
 
-static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_free_depsgraph(PrefetchWorker *worker)
 {
-  if (pfjob->depsgraph != nullptr) {
-    DEG_graph_free(pfjob->depsgraph);
+  if (worker->depsgraph != nullptr) {
+    DEG_graph_free(worker->depsgraph);
   }
-  pfjob->depsgraph = nullptr;
-  pfjob->scene_eval = nullptr;
+  worker->depsgraph = nullptr;
+  worker->scene_eval = nullptr;
 }
 
-static void seq_prefetch_update_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_update_depsgraph(PrefetchWorker *worker)
 {
-  DEG_evaluate_on_framechange(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  PrefetchJob *pfjob = worker->pfjob;
+  BLI_mutex_lock(&pfjob->depsgraph_eval_mutex);
+  DEG_evaluate_on_framechange(worker->depsgraph, worker->timeline_frame);
+  BLI_mutex_unlock(&pfjob->depsgraph_eval_mutex);
 }
 
-static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_init_depsgraph(PrefetchWorker *worker)
 {
+  PrefetchJob *pfjob = worker->pfjob;
   Main *bmain = pfjob->bmain_eval;
   Scene *scene = pfjob->scene;
   ViewLayer *view_layer = BKE_view_layer_default_render(scene);
 
-  pfjob->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(pfjob->depsgraph, "SEQUENCER PREFETCH");
+  worker->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+  DEG_debug_name_set(worker->depsgraph, "SEQUENCER PREFETCH");
 
   /* Make sure there is a correct evaluated scene pointer. */
-  DEG_graph_build_for_render_pipeline(pfjob->depsgraph);
+  DEG_graph_build_for_render_pipeline(worker->depsgraph);
 
   /* Update immediately so we have proper evaluated scene. */
-  seq_prefetch_update_depsgraph(pfjob);
+  worker->timeline_frame = seq_prefetch_cfra(pfjob);
+  seq_prefetch_update_depsgraph(worker);
 
-  pfjob->scene_eval = DEG_get_evaluated_scene(pfjob->depsgraph);
-  pfjob->scene_eval->ed->cache_flag = 0;
+  worker->scene_eval = DEG_get_evaluated_scene(worker->depsgraph);
+  worker->scene_eval->ed->cache_flag = 0;
 }
 
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
@@ -256,7 +318,7 @@ void SEQ_prefetch_stop(Scene *scene)
   pfjob->stop = true;
 
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -265,19 +327,22 @@ static void seq_prefetch_update_context(const SeqRenderData *context)
   PrefetchJob *pfjob;
   pfjob = seq_prefetch_job_get(context->scene);
 
-  SEQ_render_new_render_data(pfjob->bmain_eval,
-                             pfjob->depsgraph,
-                             pfjob->scene_eval,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context_cpy);
-  pfjob->context_cpy.is_prefetch_render = true;
-  pfjob->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+  for (PrefetchWorker &worker : pfjob->workers) {
+    SEQ_render_new_render_data(pfjob->bmain_eval,
+                               worker.depsgraph,
+                               worker.scene_eval,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &worker.context_cpy);
+    worker.context_cpy.is_prefetch_render = true;
+    worker.context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+    worker.context_cpy.skip_cache = seq_prefetch_use_concurrent_workers(pfjob);
+  }
 
   SEQ_render_new_render_data(pfjob->bmain,
-                             pfjob->depsgraph,
+                             pfjob->workers.first().depsgraph,
                              pfjob->scene,
                              context->rectx,
                              context->recty,
@@ -302,21 +367,26 @@ static void seq_prefetch_update_scene(Scene *scene)
   }
 
   pfjob->scene = scene;
-  seq_prefetch_free_depsgraph(pfjob);
-  seq_prefetch_init_depsgraph(pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    seq_prefetch_free_depsgraph(&worker);
+    seq_prefetch_init_depsgraph(&worker);
+  }
 }
 
 static void seq_prefetch_update_active_seqbase(PrefetchJob *pfjob)
 {
   MetaStack *ms_orig = SEQ_meta_stack_active_get(SEQ_editing_get(pfjob->scene));
-  Editing *ed_eval = SEQ_editing_get(pfjob->scene_eval);
 
-  if (ms_orig != nullptr) {
-    Strip *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, pfjob->scene_eval);
-    SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
-  }
-  else {
-    SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    Editing *ed_eval = SEQ_editing_get(worker.scene_eval);
+
+    if (ms_orig != nullptr) {
+      Strip *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, worker.scene_eval);
+      SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
+    }
+    else {
+      SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+    }
   }
 }
 
@@ -325,7 +395,7 @@ static void seq_prefetch_resume(Scene *scene)
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
   if (pfjob && pfjob->waiting) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -338,22 +408,27 @@ void seq_prefetch_free(Scene *scene)
 
   SEQ_prefetch_stop(scene);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
+  BLI_mutex_end(&pfjob->cache_put_mutex);
+  BLI_mutex_end(&pfjob->depsgraph_eval_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
-  seq_prefetch_free_depsgraph(pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    seq_prefetch_free_depsgraph(&worker);
+  }
   BKE_main_free(pfjob->bmain_eval);
   scene->ed->prefetch_job = nullptr;
   MEM_delete(pfjob);
 }
 
-static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
+static bool seq_prefetch_seq_has_disk_cache(PrefetchWorker *worker,
                                             Strip *strip,
                                             bool can_have_final_image)
 {
-  SeqRenderData *ctx = &pfjob->context_cpy;
-  float cfra = seq_prefetch_cfra(pfjob);
+  /* Use the original context in case the worker skips the cache. */
+  SeqRenderData *ctx = &worker->pfjob->context;
+  float cfra = worker->timeline_frame;
+  strip = seq_prefetch_get_original_sequence(strip, ctx->scene);
 
   ImBuf *ibuf = seq_cache_get(ctx, strip, cfra, SEQ_CACHE_STORE_PREPROCESSED);
   if (ibuf != nullptr) {
@@ -380,28 +455,28 @@ static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
   return false;
 }
 
-static bool seq_prefetch_scene_strip_is_rendered(PrefetchJob *pfjob,
+static bool seq_prefetch_scene_strip_is_rendered(PrefetchWorker *worker,
                                                  ListBase *channels,
                                                  ListBase *seqbase,
                                                  blender::Span<Strip *> scene_strips,
                                                  bool is_recursive_check)
 {
-  float cfra = seq_prefetch_cfra(pfjob);
+  float cfra = worker->timeline_frame;
   blender::Vector<Strip *> strips = seq_get_shown_sequences(
-      pfjob->scene_eval, channels, seqbase, cfra, 0);
+      worker->scene_eval, channels, seqbase, cfra, 0);
 
   /* Iterate over rendered strips. */
   for (Strip *strip : strips) {
     if (strip->type == STRIP_TYPE_META &&
         seq_prefetch_scene_strip_is_rendered(
-            pfjob, &strip->channels, &strip->seqbase, scene_strips, true))
+            worker, &strip->channels, &strip->seqbase, scene_strips, true))
     {
       return true;
     }
 
     /* Disable prefetching 3D scene strips, but check for disk cache. */
     if (strip->type == STRIP_TYPE_SCENE && (strip->flag & SEQ_SCENE_STRIPS) == 0 &&
-        !seq_prefetch_seq_has_disk_cache(pfjob, strip, !is_recursive_check))
+        !seq_prefetch_seq_has_disk_cache(worker, strip, !is_recursive_check))
     {
       return true;
     }
@@ -429,10 +504,12 @@ static blender::VectorSet<Strip *> query_scene_strips(ListBase *seqbase)
 
 /* Prefetch must avoid rendering scene strips, because rendering in background locks UI and can
  * make it unresponsive for long time periods. */
-static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels, ListBase *seqbase)
+static bool seq_prefetch_must_skip_frame(PrefetchWorker *worker,
+                                         ListBase *channels,
+                                         ListBase *seqbase)
 {
   blender::VectorSet<Strip *> scene_strips = query_scene_strips(seqbase);
-  if (seq_prefetch_scene_strip_is_rendered(pfjob, channels, seqbase, scene_strips, false)) {
+  if (seq_prefetch_scene_strip_is_rendered(worker, channels, seqbase, scene_strips, false)) {
     return true;
   }
   return false;
@@ -444,32 +521,164 @@ static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
          (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
 }
 
-static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
+/* The job is waiting if all of its running workers are waiting. Expects the suspend mutex to be
+ * locked. */
+static void seq_prefetch_update_waiting(PrefetchJob *pfjob)
+{
+  int num_workers_waiting = 0;
+  for (const PrefetchWorker &worker : pfjob->workers) {
+    num_workers_waiting += worker.is_waiting;
+  }
+  pfjob->waiting = num_workers_waiting > 0 && num_workers_waiting == pfjob->num_workers_running;
+}
+
+static void seq_prefetch_do_suspend(PrefetchWorker *worker)
 {
+  PrefetchJob *pfjob = worker->pfjob;
+
   BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   while (seq_prefetch_need_suspend(pfjob) &&
          (pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) && !pfjob->stop)
   {
-    pfjob->waiting = true;
+    worker->is_waiting = true;
+    seq_prefetch_update_waiting(pfjob);
     BLI_condition_wait(&pfjob->prefetch_suspend_cond, &pfjob->prefetch_suspend_mutex);
     seq_prefetch_update_area(pfjob);
   }
-  pfjob->waiting = false;
+  worker->is_waiting = false;
+  seq_prefetch_update_waiting(pfjob);
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+}
+
+/* Put the frames rendered by the workers in the cache in the order of the timeline, such that the
+ * cache doesn't get holes in the prefetched range when it gets full. Frames are only put once all
+ * frames before them were rendered, so the given frame, if any, might be kept until another
+ * worker finishes rendering an earlier frame. If the job finished, all remaining frames are put.
+ * Takes ownership of the image of the given frame. */
+static void seq_prefetch_put_rendered_frames(PrefetchWorker *worker,
+                                             const PrefetchRenderedFrame *rendered_frame)
+{
+  PrefetchJob *pfjob = worker->pfjob;
+
+  /* Lock the cache put mutex first, such that frames collected by different workers are put in
+   * the order they were collected. */
+  BLI_mutex_lock(&pfjob->cache_put_mutex);
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  worker->is_rendering = false;
+  if (rendered_frame) {
+    pfjob->rendered_frames.append(*rendered_frame);
+  }
+
+  int first_frame_in_flight = std::numeric_limits<int>::max();
+  for (const PrefetchWorker &other_worker : pfjob->workers) {
+    if (other_worker.is_rendering) {
+      first_frame_in_flight = std::min(first_frame_in_flight, other_worker.timeline_frame);
+    }
+  }
+
+  blender::Vector<PrefetchRenderedFrame> frames_to_put;
+  pfjob->rendered_frames.remove_if([&](const PrefetchRenderedFrame &frame) {
+    if (frame.timeline_frame < first_frame_in_flight) {
+      frames_to_put.append(frame);
+      return true;
+    }
+    return false;
+  });
   BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  std::sort(frames_to_put.begin(),
+            frames_to_put.end(),
+            [](const PrefetchRenderedFrame &a, const PrefetchRenderedFrame &b) {
+              return a.timeline_frame < b.timeline_frame;
+            });
+  for (const PrefetchRenderedFrame &frame : frames_to_put) {
+    seq_render_cache_put_final_out(&pfjob->context, frame.strip, frame.timeline_frame, frame.ibuf);
+    IMB_freeImBuf(frame.ibuf);
+  }
+
+  BLI_mutex_unlock(&pfjob->cache_put_mutex);
 }
 
-static void *seq_prefetch_frames(void *job)
+/* Render the current frame of the worker. If the worker skips the cache, the final image is
+ * returned to be put in the cache later, otherwise, it is already put in the cache while
+ * rendering. */
+static std::optional<PrefetchRenderedFrame> seq_prefetch_render_frame(PrefetchWorker *worker)
 {
-  PrefetchJob *pfjob = (PrefetchJob *)job;
+  PrefetchJob *pfjob = worker->pfjob;
+  const int timeline_frame = worker->timeline_frame;
+
+  if (!worker->context_cpy.skip_cache) {
+    ImBuf *ibuf = SEQ_render_give_ibuf(&worker->context_cpy, timeline_frame, 0);
+    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, timeline_frame);
+    IMB_freeImBuf(ibuf);
+    return std::nullopt;
+  }
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
-    pfjob->scene_eval->ed->prefetch_job = nullptr;
+  Editing *ed_eval = SEQ_editing_get(worker->scene_eval);
+  blender::Vector<Strip *> strips = seq_get_shown_sequences(worker->scene_eval,
+                                                            SEQ_channels_displayed_get(ed_eval),
+                                                            SEQ_active_seqbase_get(ed_eval),
+                                                            timeline_frame,
+                                                            0);
+  if (strips.is_empty()) {
+    return std::nullopt;
+  }
+
+  Strip *strip = seq_prefetch_get_original_sequence(strips.last(), pfjob->scene);
+  if (strip == nullptr) {
+    return std::nullopt;
+  }
+
+  /* The frame might already be cached, since the worker skips the cache, check it here. */
+  ImBuf *cached_ibuf = seq_cache_get(
+      &pfjob->context, strip, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT);
+  if (cached_ibuf != nullptr) {
+    IMB_freeImBuf(cached_ibuf);
+    return std::nullopt;
+  }
+
+  ImBuf *ibuf = SEQ_render_give_ibuf(&worker->context_cpy, timeline_frame, 0);
+  if (ibuf == nullptr) {
+    return std::nullopt;
+  }
+
+  return PrefetchRenderedFrame{timeline_frame, strip, ibuf};
+}
 
-    seq_prefetch_update_depsgraph(pfjob);
-    AnimData *adt = BKE_animdata_from_id(&pfjob->context_cpy.scene->id);
-    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(pfjob);
+/* Claim the next frame to be prefetched by the given worker. Returns false if there are no more
+ * frames to prefetch. */
+static bool seq_prefetch_claim_frame(PrefetchWorker *worker)
+{
+  PrefetchJob *pfjob = worker->pfjob;
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  seq_prefetch_update_area(pfjob);
+  const int timeline_frame = seq_prefetch_cfra(pfjob);
+  const bool has_frame = timeline_frame <= pfjob->scene->r.efra;
+  if (has_frame) {
+    pfjob->num_frames_prefetched++;
+    worker->timeline_frame = timeline_frame;
+    worker->is_rendering = true;
+  }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  return has_frame;
+}
+
+static void *seq_prefetch_frames(void *worker_data)
+{
+  PrefetchWorker *worker = static_cast<PrefetchWorker *>(worker_data);
+  PrefetchJob *pfjob = worker->pfjob;
+
+  while (seq_prefetch_claim_frame(worker)) {
+    worker->scene_eval->ed->prefetch_job = nullptr;
+
+    seq_prefetch_update_depsgraph(worker);
+    AnimData *adt = BKE_animdata_from_id(&worker->context_cpy.scene->id);
+    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(worker);
     BKE_animsys_evaluate_animdata(
-        &pfjob->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
+        &worker->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
 
     /* This is quite hacky solution:
      * We need cross-reference original scene with copy for cache.
@@ -477,12 +686,12 @@ static void *seq_prefetch_frames(void *job)
      * Scene copy don't reference original scene. Perhaps, this could be done by depsgraph.
      * Set to nullptr before return!
      */
-    pfjob->scene_eval->ed->prefetch_job = pfjob;
+    worker->scene_eval->ed->prefetch_job = pfjob;
 
-    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(pfjob->scene_eval));
-    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(pfjob->scene_eval));
-    if (seq_prefetch_must_skip_frame(pfjob, channels, seqbase)) {
-      pfjob->num_frames_prefetched++;
+    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(worker->scene_eval));
+    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(worker->scene_eval));
+    if (seq_prefetch_must_skip_frame(worker, channels, seqbase)) {
+      seq_prefetch_put_rendered_frames(worker, nullptr);
       /* Break instead of keep looping if the job should be terminated. */
       if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
         break;
@@ -490,12 +699,11 @@ static void *seq_prefetch_frames(void *job)
       continue;
     }
 
-    ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
-    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-    IMB_freeImBuf(ibuf);
+    const std::optional<PrefetchRenderedFrame> rendered_frame = seq_prefetch_render_frame(worker);
+    seq_prefetch_put_rendered_frames(worker, rendered_frame ? &*rendered_frame : nullptr);
 
     /* Suspend thread if there is nothing to be prefetched. */
-    seq_prefetch_do_suspend(pfjob);
+    seq_prefetch_do_suspend(worker);
 
     /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
     if (pfjob->num_frames_prefetched > 5 && (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2)
@@ -506,14 +714,23 @@ static void *seq_prefetch_frames(void *job)
     if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
       break;
     }
-
-    seq_prefetch_update_area(pfjob);
-    pfjob->num_frames_prefetched++;
   }
 
-  seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
-  pfjob->scene_eval->ed->prefetch_job = nullptr;
+  worker->scene_eval->ed->prefetch_job = nullptr;
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  worker->is_rendering = false;
+  pfjob->num_workers_running--;
+  const bool is_last_worker = pfjob->num_workers_running == 0;
+  seq_prefetch_update_waiting(pfjob);
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  if (is_last_worker) {
+    /* No frames are in flight anymore, so all remaining rendered frames are put. */
+    seq_prefetch_put_rendered_frames(worker, nullptr);
+    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+    pfjob->running = false;
+  }
 
   return nullptr;
 }
@@ -529,13 +746,20 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
     pfjob = MEM_new<PrefetchJob>("PrefetchJob");
     context->scene->ed->prefetch_job = pfjob;
 
-    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
+    const int workers_num = seq_prefetch_workers_num();
+    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, workers_num);
     BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
+    BLI_mutex_init(&pfjob->cache_put_mutex);
+    BLI_mutex_init(&pfjob->depsgraph_eval_mutex);
     BLI_condition_init(&pfjob->prefetch_suspend_cond);
 
+    pfjob->workers.reinitialize(workers_num);
+    for (PrefetchWorker &worker : pfjob->workers) {
+      worker.pfjob = pfjob;
+    }
+
     pfjob->bmain_eval = BKE_main_new();
     pfjob->scene = context->scene;
-    seq_prefetch_init_depsgraph(pfjob);
   }
   pfjob->bmain = context->bmain;
 
@@ -550,8 +774,13 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   seq_prefetch_update_context(context);
   seq_prefetch_update_active_seqbase(pfjob);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
-  BLI_threadpool_insert(&pfjob->threads, pfjob);
+  pfjob->num_workers_running = pfjob->workers.size();
+  for (PrefetchWorker &worker : pfjob->workers) {
+    BLI_threadpool_remove(&pfjob->threads, &worker);
+    worker.is_rendering = false;
+    worker.is_waiting = false;
+    BLI_threadpool_insert(&pfjob->threads, &worker);
+  }
 
   return pfjob;
 }
@@ -285,7 +285,8 @@ static void seq_proxy_build_frame(const SeqRenderData *context,
   int recty = (proxy_render_size * ibuf_tmp->y) / 100;
 
   if (ibuf_tmp->x != rectx || ibuf_tmp->y != recty) {
-    ibuf = IMB_scale_into_new(ibuf_tmp, rectx, recty, IMBScaleFilter::Nearest, true);
+    /* Proxies are scaled down by up to 4x, nearest sampling would alias badly. */
+    ibuf = IMB_scale_into_new(ibuf_tmp, rectx, recty, IMBScaleFilter::Lanczos, true);
     IMB_freeImBuf(ibuf_tmp);
   }
   else {
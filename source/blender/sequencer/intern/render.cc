@@ -18,12 +18,14 @@
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_rect.h"
+#include "BLI_set.hh"
 #include "BLI_task.hh"
 
 #include "BKE_anim_data.hh"
@@ -1850,6 +1852,108 @@ static bool is_opaque_alpha_over(const Strip *strip)
   return true;
 }
 
+/**
+ * Check whether rendering the strip only reads the strip itself and its effect inputs, which are
+ * added to \a r_strips. Strips that render other parts of the timeline or other scenes, or that
+ * use masks, are rendered in channel order instead.
+ */
+static bool seq_can_render_concurrently(Strip *strip, Set<Strip *> &r_strips)
+{
+  if (!r_strips.add(strip)) {
+    /* Inputs used more than once by the same strip are rendered in order by that strip. */
+    return true;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &strip->modifiers) {
+    if (smd->mask_sequence != nullptr || smd->mask_id != nullptr) {
+      return false;
+    }
+  }
+
+  switch (strip->type) {
+    case STRIP_TYPE_IMAGE:
+    case STRIP_TYPE_MOVIE:
+      return true;
+    case STRIP_TYPE_META:
+    case STRIP_TYPE_SCENE:
+    case STRIP_TYPE_MOVIECLIP:
+    case STRIP_TYPE_MASK:
+    case STRIP_TYPE_SOUND_RAM:
+    case STRIP_TYPE_ADJUSTMENT:
+    case STRIP_TYPE_MULTICAM:
+      return false;
+  }
+
+  if ((strip->type & STRIP_TYPE_EFFECT) == 0) {
+    return false;
+  }
+  for (Strip *input : {strip->seq1, strip->seq2}) {
+    if (input != nullptr && !seq_can_render_concurrently(input, r_strips)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Render the strips of the stack from \a start that will be blended on top of each other, such
+ * that strips that don't share any inputs are rendered concurrently. Blending itself is done in
+ * channel order afterwards. Returns the rendered images indexed like the strips, images of strips
+ * that can't be rendered concurrently are nullptr and should be rendered while blending.
+ */
+static Array<ImBuf *> seq_render_strips_concurrently(const SeqRenderData *context,
+                                                     SeqRenderState *state,
+                                                     Span<Strip *> strips,
+                                                     const int64_t start,
+                                                     const OpaqueQuadTracker &opaques,
+                                                     float timeline_frame)
+{
+  Array<ImBuf *> ibufs(strips.size(), nullptr);
+
+  Vector<int64_t> concurrent_indices;
+  Set<Strip *> rendered_strips;
+  for (const int64_t i : strips.index_range().drop_front(start)) {
+    Strip *strip = strips[i];
+    if (opaques.is_occluded(context, strip, i) ||
+        strip_get_early_out_for_blend_mode(strip) != StripEarlyOut::DoEffect)
+    {
+      continue;
+    }
+
+    Set<Strip *> strip_inputs;
+    if (!seq_can_render_concurrently(strip, strip_inputs)) {
+      continue;
+    }
+    const bool shares_inputs = std::any_of(
+        strip_inputs.begin(), strip_inputs.end(), [&](Strip *input) {
+          return rendered_strips.contains(input);
+        });
+    if (shares_inputs) {
+      continue;
+    }
+
+    for (Strip *input : strip_inputs) {
+      rendered_strips.add(input);
+    }
+    concurrent_indices.append(i);
+  }
+
+  if (concurrent_indices.size() < 2) {
+    return ibufs;
+  }
+
+  threading::parallel_for(concurrent_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : concurrent_indices.as_span().slice(range)) {
+      /* Rendering of each strip is multi-threaded as well, isolate it, such that a thread that
+       * waits for that work doesn't start rendering another strip in the meantime. */
+      threading::isolate_task(
+          [&]() { ibufs[i] = seq_render_strip(context, state, strips[i], timeline_frame); });
+    }
+  });
+
+  return ibufs;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1952,6 +2056,12 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  /* Strips blended on top of each other don't depend on each other, so render them concurrently
+   * where possible. Blending and effects are multi-threaded themselves. */
+  Array<ImBuf *> rendered_ibufs = seq_render_strips_concurrently(
+      context, state, strips, i, opaques, timeline_frame);
+
   for (; i < strips.size(); i++) {
     Strip *strip = strips[i];
 
@@ -1961,7 +2071,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (strip_get_early_out_for_blend_mode(strip) == StripEarlyOut::DoEffect) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, strip, timeline_frame);
+      ImBuf *ibuf2 = rendered_ibufs[i] ? rendered_ibufs[i] :
+                                         seq_render_strip(context, state, strip, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, strip, timeline_frame, ibuf1, ibuf2);
 
@@ -2012,7 +2123,16 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
   SEQ_relations_free_all_anim_ibufs(context->scene, timeline_frame);
 
   if (!strips.is_empty() && !out) {
-    BLI_mutex_lock(&seq_render_mutex);
+    /* Renders are serialized because the cache links its entries in the order they are put. But
+     * prefetch renders that skip the cache can run concurrently, see
+     * #seq_render_cache_put_final_out. This relies on the invariant that each prefetch worker
+     * renders from the evaluated scene of its own depsgraph, and that the evaluation of those
+     * depsgraphs, which all share the evaluated Main of the prefetch job, is serialized by the
+     * depsgraph evaluation mutex of the job, see #seq_prefetch_update_depsgraph. */
+    const bool use_render_mutex = !(context->is_prefetch_render && context->skip_cache);
+    if (use_render_mutex) {
+      BLI_mutex_lock(&seq_render_mutex);
+    }
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
 
     if (context->is_prefetch_render) {
@@ -2022,7 +2142,9 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
       seq_cache_put_if_possible(
           context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
-    BLI_mutex_unlock(&seq_render_mutex);
+    if (use_render_mutex) {
+      BLI_mutex_unlock(&seq_render_mutex);
+    }
   }
 
   seq_prefetch_start(context, timeline_frame);
@@ -2030,6 +2152,16 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
   return out;
 }
 
+void seq_render_cache_put_final_out(const SeqRenderData *context,
+                                    Strip *strip,
+                                    float timeline_frame,
+                                    ImBuf *ibuf)
+{
+  BLI_mutex_lock(&seq_render_mutex);
+  seq_cache_put(context, strip, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, ibuf);
+  BLI_mutex_unlock(&seq_render_mutex);
+}
+
 ImBuf *seq_render_give_ibuf_seqbase(const SeqRenderData *context,
                                     float timeline_frame,
                                     int chan_shown,
@@ -41,6 +41,16 @@ ImBuf *seq_render_give_ibuf_seqbase(const SeqRenderData *context,
                                     int chan_shown,
                                     ListBase *channels,
                                     ListBase *seqbasep);
+/**
+ * Put the final image of a frame rendered with a context that skips the cache into the cache.
+ * This is serialized with other renders, since the cache links its entries in the order they are
+ * put and a render in progress on another thread would otherwise get its entries linked with the
+ * given frame.
+ */
+void seq_render_cache_put_final_out(const SeqRenderData *context,
+                                    Strip *strip,
+                                    float timeline_frame,
+                                    ImBuf *ibuf);
 void seq_imbuf_to_sequencer_space(const Scene *scene, ImBuf *ibuf, bool make_float);
 blender::Vector<Strip *> seq_get_shown_sequences(
     const Scene *scene, ListBase *channels, ListBase *seqbase, int timeline_frame, int chanshown);
@@ -658,6 +658,7 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--render-output");
   BLI_args_print_arg_doc(ba, "--engine");
   BLI_args_print_arg_doc(ba, "--threads");
+  BLI_args_print_arg_doc(ba, "--profile-compositor");
 
   if (defs.with_cycles) {
     PRINT("Cycles Render Options:\n");
@@ -2059,6 +2060,22 @@ static int arg_handle_threads_set(int argc, const char **argv, void * /*data*/)
   return 0;
 }
 
+static const char arg_handle_profile_compositor_set_doc[] =
+    "<path>\n"
+    "\tProfile the compositor when rendering, writing the evaluation time and memory usage of\n"
+    "\toperations to <path> in the Trace Event Format.\n"
+    "\tUse '#' in <path> to be replaced with the frame number, otherwise every frame overwrites\n"
+    "\tthe file of the previous one.";
+static int arg_handle_profile_compositor_set(int argc, const char **argv, void * /*data*/)
+{
+  if (argc > 1) {
+    STRNCPY(G.profile_compositor_filepath, argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a path after '--profile-compositor'.\n");
+  return 0;
+}
+
 static const char arg_handle_verbosity_set_doc[] =
     "<verbose>\n"
     "\tSet the logging verbosity level for debug messages that support it.";
@@ -2670,6 +2687,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                nullptr);
 
   BLI_args_add(ba, "-t", "--threads", CB(arg_handle_threads_set), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--profile-compositor", CB(arg_handle_profile_compositor_set), nullptr);
 
   /* Include in the environment pass so it's possible display errors initializing subsystems,
    * especially `bpy.appdir` since it's useful to show errors finding paths on startup. */
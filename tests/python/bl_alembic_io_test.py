@@ -340,6 +340,93 @@ class CameraExportImportTest(unittest.TestCase):
         self.assertAlmostEqual(1, actual_scale.z, delta=delta_scale)
 
 
+class ParallelFramesExportTest(unittest.TestCase):
+    """Exporting with frames evaluated ahead should give the same result as evaluating
+    every frame right before writing it."""
+
+    frame_start = 1
+    frame_end = 12
+
+    def setUp(self):
+        self._tempdir = tempfile.TemporaryDirectory()
+        self.tempdir = pathlib.Path(self._tempdir.name)
+
+    def tearDown(self):
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        self._tempdir.cleanup()
+
+    def create_animated_scene(self):
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        scene = bpy.context.scene
+        scene.frame_start = self.frame_start
+        scene.frame_end = self.frame_end
+
+        size = 6
+        verts = [(x, y, 0.0) for y in range(size) for x in range(size)]
+        faces = [(y * size + x, y * size + x + 1, (y + 1) * size + x + 1, (y + 1) * size + x)
+                 for y in range(size - 1) for x in range(size - 1)]
+        mesh = bpy.data.meshes.new("Grid")
+        mesh.from_pydata(verts, [], faces)
+        ob = bpy.data.objects.new("Grid", mesh)
+        scene.collection.objects.link(ob)
+
+        # Keyframed transform, a time dependent deformation and a driver.
+        ob.location = (0, 0, 0)
+        ob.keyframe_insert("location", frame=self.frame_start)
+        ob.location = (1, 2, 3)
+        ob.keyframe_insert("location", frame=self.frame_end)
+        ob.modifiers.new("Wave", 'WAVE')
+        driver = ob.driver_add("scale", 2).driver
+        driver.type = 'SCRIPTED'
+        driver.expression = "1 + frame * 0.1"
+
+    def export_and_read_back(self, parallel_frames: int) -> list:
+        self.create_animated_scene()
+        abc_path = self.tempdir / f"parallel_{parallel_frames}.abc"
+        self.assertIn('FINISHED', bpy.ops.wm.alembic_export(
+            filepath=str(abc_path),
+            start=self.frame_start,
+            end=self.frame_end,
+            parallel_frames=parallel_frames,
+        ))
+
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        self.assertIn('FINISHED', bpy.ops.wm.alembic_import(filepath=str(abc_path)))
+        ob = bpy.context.scene.collection.objects['Grid']
+
+        frames = []
+        for frame in range(self.frame_start, self.frame_end + 1):
+            bpy.context.scene.frame_set(frame)
+            depsgraph = bpy.context.evaluated_depsgraph_get()
+            ob_eval = ob.evaluated_get(depsgraph)
+            positions = [tuple(v.co) for v in ob_eval.data.vertices]
+            matrix = [tuple(row) for row in ob_eval.matrix_world]
+            frames.append((positions, matrix))
+        return frames
+
+    def test_parallel_frames_match_sequential(self):
+        sequential = self.export_and_read_back(parallel_frames=1)
+        parallel = self.export_and_read_back(parallel_frames=4)
+        self.assertEqual(len(sequential), len(parallel))
+
+        for frame_index, (expect, actual) in enumerate(zip(sequential, parallel)):
+            expect_positions, expect_matrix = expect
+            actual_positions, actual_matrix = actual
+            self.assertEqual(len(expect_positions), len(actual_positions))
+            for expect_co, actual_co in zip(expect_positions, actual_positions):
+                self.assertAlmostEqualFloatArray(actual_co, expect_co, frame_index)
+            for expect_row, actual_row in zip(expect_matrix, actual_matrix):
+                self.assertAlmostEqualFloatArray(actual_row, expect_row, frame_index)
+
+        # Make sure the test actually covers animated data.
+        self.assertNotEqual(sequential[0], sequential[-1])
+
+    def assertAlmostEqualFloatArray(self, actual, expect, frame_index):
+        for act, exp in zip(actual, expect):
+            self.assertAlmostEqual(act, exp, places=6,
+                                   msg='%f != %f at frame index %d' % (act, exp, frame_index))
+
+
 class OverrideLayersTest(AbstractAlembicTest):
     def test_import_layer(self):
         fname = 'cube-base-file.abc'
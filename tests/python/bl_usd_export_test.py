@@ -306,6 +306,65 @@ class USDExportTest(AbstractUSDTest):
         geom_subsets = UsdGeom.Subset.GetGeomSubsets(dynamic_mesh_prim)
         self.assertEqual(len(geom_subsets), 0)
 
+    def test_export_parallel_frames(self):
+        """Exporting with frames evaluated ahead should give the same result as evaluating every
+        frame right before writing it."""
+
+        def create_animated_scene():
+            bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+            scene = bpy.context.scene
+            scene.frame_start = 1
+            scene.frame_end = 12
+
+            size = 6
+            verts = [(x, y, 0.0) for y in range(size) for x in range(size)]
+            faces = [(y * size + x, y * size + x + 1, (y + 1) * size + x + 1, (y + 1) * size + x)
+                     for y in range(size - 1) for x in range(size - 1)]
+            mesh = bpy.data.meshes.new("Grid")
+            mesh.from_pydata(verts, [], faces)
+            ob = bpy.data.objects.new("Grid", mesh)
+            scene.collection.objects.link(ob)
+
+            # Keyframed transform, a time dependent deformation and a driver.
+            ob.location = (0, 0, 0)
+            ob.keyframe_insert("location", frame=1)
+            ob.location = (1, 2, 3)
+            ob.keyframe_insert("location", frame=12)
+            ob.modifiers.new("Wave", 'WAVE')
+            driver = ob.driver_add("scale", 2).driver
+            driver.type = 'SCRIPTED'
+            driver.expression = "1 + frame * 0.1"
+
+        def export_and_read_back(parallel_frames):
+            create_animated_scene()
+            export_path = self.tempdir / f"parallel_{parallel_frames}.usda"
+            self.export_and_validate(
+                filepath=str(export_path),
+                export_animation=True,
+                parallel_frames=parallel_frames,
+            )
+
+            stage = Usd.Stage.Open(str(export_path))
+            prim = stage.GetPrimAtPath("/root/Grid/Grid")
+            mesh = UsdGeom.Mesh(prim)
+            frames = []
+            for frame in range(1, 13):
+                points = [tuple(p) for p in mesh.GetPointsAttr().Get(frame)]
+                matrix = UsdGeom.Xformable(prim).ComputeLocalToWorldTransform(frame)
+                frames.append((points, [tuple(row) for row in matrix]))
+            return frames
+
+        sequential = export_and_read_back(1)
+        parallel = export_and_read_back(4)
+        self.assertEqual(len(sequential), len(parallel))
+        for frame_index, (expect, actual) in enumerate(zip(sequential, parallel)):
+            for expect_values, actual_values in zip(expect[0] + expect[1], actual[0] + actual[1]):
+                for exp, act in zip(expect_values, actual_values):
+                    self.assertAlmostEqual(act, exp, places=5, msg=f"Mismatch at frame index {frame_index}")
+
+        # Make sure the test actually covers animated data.
+        self.assertNotEqual(sequential[0], sequential[-1])
+
     def test_export_material_inmem(self):
         """Validate correct export of in memory and packed images"""
 
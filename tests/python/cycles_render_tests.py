@@ -130,29 +130,41 @@ BLOCKLIST_GPU = [
 
 
 class CyclesReport(render_report.Report):
-    def __init__(self, title, output_dir, oiiotool, device=None, blocklist=[], osl=False):
+    def __init__(self, title, output_dir, oiiotool, device=None, blocklist=[], osl=False, wavefront=False):
         # Split device name in format "<device_type>[-<RT>]" into individual
         # tokens, setting the RT suffix to an empty string if its not specified.
         self.device, suffix = (device.split("-") + [""])[:2]
         self.use_hwrt = (suffix == "RT")
         self.osl = osl
+        self.wavefront = wavefront
 
         variation = self.device
         if suffix:
             variation += ' ' + suffix
         if self.osl:
             variation += ' OSL'
+        if self.wavefront:
+            variation += ' Wavefront'
 
         super().__init__(title, output_dir, oiiotool, variation, blocklist)
 
     def _get_render_arguments(self, arguments_cb, filepath, base_output_filepath):
-        return arguments_cb(filepath, base_output_filepath, self.use_hwrt, self.osl)
+        return arguments_cb(filepath, base_output_filepath, self.use_hwrt, self.osl, self.wavefront)
 
     def _get_arguments_suffix(self):
-        return ['--', '--cycles-device', self.device] if self.device else []
+        # Cycles logs which path tracing code was used, to check that the wavefront mode is used.
+        suffix = ['--debug-cycles'] if self.wavefront else []
+        if self.device:
+            suffix += ['--', '--cycles-device', self.device]
+        return suffix
 
+    def _get_process_output_error(self, output):
+        if self.wavefront and "CPU wavefront path tracing" not in output:
+            return "Render did not use CPU wavefront path tracing"
+        return None
 
-def get_arguments(filepath, output_filepath, use_hwrt=False, osl=False):
+
+def get_arguments(filepath, output_filepath, use_hwrt=False, osl=False, wavefront=False):
     dirname = os.path.dirname(filepath)
     basedir = os.path.dirname(dirname)
     subject = os.path.basename(dirname)
@@ -193,6 +205,16 @@ def get_arguments(filepath, output_filepath, use_hwrt=False, osl=False):
     if osl:
         args.extend(["--python-expr", "import bpy; bpy.context.scene.cycles.shading_system = True"])
 
+    if wavefront:
+        # Cycles only uses the debug options with the developer extras and Cycles debug preferences.
+        args.extend([
+            "--python-expr",
+            ("import bpy;"
+             "bpy.context.preferences.view.show_developer_ui = True;"
+             "bpy.context.preferences.experimental.use_cycles_debug = True;"
+             "bpy.context.scene.cycles.debug_use_cpu_wavefront = True")
+        ])
+
     if subject == 'bake':
         args.extend(['--python', os.path.join(basedir, "util", "render_bake.py")])
     elif subject == 'denoise_animation':
@@ -214,6 +236,7 @@ def create_argparse():
     parser.add_argument("--device", required=True)
     parser.add_argument("--blocklist", nargs="*", default=[])
     parser.add_argument("--osl", default=False, action='store_true')
+    parser.add_argument("--wavefront", default=False, action='store_true')
     parser.add_argument('--batch', default=False, action='store_true')
     return parser
 
@@ -238,7 +261,7 @@ def main():
     if args.osl:
         blocklist += BLOCKLIST_OSL
 
-    report = CyclesReport('Cycles', args.outdir, args.oiiotool, device, blocklist, args.osl)
+    report = CyclesReport('Cycles', args.outdir, args.oiiotool, device, blocklist, args.osl, args.wavefront)
     report.set_pixelated(True)
     report.set_reference_dir("cycles_renders")
     if device == 'CPU':
@@ -486,6 +486,13 @@ class Report:
         # Each render test is supposed to override this method.
         return []
 
+    def _get_process_output_error(self, output):
+        # Check the output of the Blender process, including stderr, and return an error message
+        # when it is not as expected.
+        #
+        # Each render test can override this method.
+        return None
+
     def _get_filepath_tests(self, filepath):
         list_filepath = filepath.replace('.blend', '_permutations.txt')
         if os.path.exists(list_filepath):
@@ -530,18 +537,24 @@ class Report:
             # Run process
             crash = False
             output = None
+            output_error = None
             try:
-                completed_process = subprocess.run(command, stdout=subprocess.PIPE)
+                completed_process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
                 if completed_process.returncode != 0:
                     crash = True
                 output = completed_process.stdout
             except Exception:
                 crash = True
 
+            if not crash:
+                output_error = self._get_process_output_error(output.decode("utf-8", 'ignore'))
+
             if verbose:
                 print(" ".join(command))
-            if (verbose or crash) and output:
+            if (verbose or crash or output_error) and output:
                 print(output.decode("utf-8", 'ignore'))
+            if output_error:
+                print_message(output_error)
 
             tests_to_check = []
 
@@ -560,6 +573,9 @@ class Report:
                         else:
                             test.error = "NO OUTPUT"
                             test_results.append(test)
+                    elif output_error:
+                        test.error = "PROCESS OUTPUT"
+                        test_results.append(test)
                     else:
                         tests_to_check.append(test)
                 if file_crashed:
@@ -578,6 +594,9 @@ class Report:
             elif test.error == "NO OUTPUT":
                 print_message("No render result file found")
                 print_message(test.tmp_out_img, 'FAILURE', 'FAILED')
+            elif test.error == "PROCESS OUTPUT":
+                print_message("Unexpected output from Blender")
+                print_message(test.name, 'FAILURE', 'FAILED')
             elif test.error == "VERIFY":
                 print_message("Render result is different from reference image")
                 print_message(test.name, 'FAILURE', 'FAILED')